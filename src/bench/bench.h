@@ -0,0 +1,252 @@
+/**
+ * Benchmark framework for the `bench` target
+ *
+ * Grown out of the Timer in 7.6.performance_tips.cpp, with the pieces a
+ * single stopwatch loop is missing:
+ *   - warm-up before measuring (caches, branch predictors, CPU clocks)
+ *   - auto-calibrated batch size so one sample is long enough to time
+ *   - many samples per case -> min / median / mean / stddev / p90 / p99
+ *   - doNotOptimize() / clobberMemory() so the compiler cannot delete the work
+ *   - JSON output that can be diffed against a baseline run
+ *
+ * Usage:
+ *   BENCH_CASE("ch1/fixed_product_4x4") {
+ *       Eigen::Matrix4d A = Eigen::Matrix4d::Random();
+ *       while (state.keepRunning()) {
+ *           Eigen::Matrix4d C = A * A;
+ *           bench::doNotOptimize(C);
+ *       }
+ *   }
+ */
+
+#ifndef EIGEN_TUTORIAL_BENCH_H
+#define EIGEN_TUTORIAL_BENCH_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+// Same idea as the 7.6 Timer, but on a monotonic clock and in nanoseconds
+class Timer {
+public:
+    void start() { t_start = std::chrono::steady_clock::now(); }
+    double elapsed_ns() const {
+        auto t_end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(t_end - t_start).count();
+    }
+private:
+    std::chrono::time_point<std::chrono::steady_clock> t_start;
+};
+
+// Optimization barriers: make the compiler believe `value` is read (and may be
+// written), so a result that is otherwise unused cannot be eliminated.
+#if defined(__GNUC__) || defined(__clang__)
+template <typename T>
+inline void doNotOptimize(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+template <typename T>
+inline void doNotOptimize(T& value) {
+    asm volatile("" : "+m"(value) : : "memory");
+}
+inline void clobberMemory() { asm volatile("" : : : "memory"); }
+#else
+template <typename T>
+inline void doNotOptimize(T const& value) {
+    const volatile char* sink = reinterpret_cast<const volatile char*>(&value);
+    (void)*sink;
+}
+inline void clobberMemory() { std::atomic_signal_fence(std::memory_order_seq_cst); }
+#endif
+
+struct Config {
+    int repetitions = 20;         // Samples per case
+    double warmup_ms = 50.0;      // Minimum warm-up time per case
+    double min_sample_ms = 2.0;   // Each sample runs at least this long
+    double max_case_s = 10.0;     // Stop sampling a case after this budget
+};
+
+struct Stats {
+    double min_ns = 0, max_ns = 0, mean_ns = 0, stddev_ns = 0;
+    double median_ns = 0, p90_ns = 0, p99_ns = 0;
+};
+
+// Linear interpolation between closest ranks, q in [0, 1]
+inline double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0.0;
+    double pos = q * (sorted.size() - 1);
+    size_t lo = static_cast<size_t>(std::floor(pos));
+    size_t hi = std::min(lo + 1, sorted.size() - 1);
+    double frac = pos - lo;
+    return sorted[lo] * (1.0 - frac) + sorted[hi] * frac;
+}
+
+inline Stats computeStats(std::vector<double> samples) {
+    Stats s;
+    if (samples.empty()) return s;
+    std::sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (double v : samples) sum += v;
+    s.mean_ns = sum / samples.size();
+    double sq = 0;
+    for (double v : samples) sq += (v - s.mean_ns) * (v - s.mean_ns);
+    s.stddev_ns = samples.size() > 1 ? std::sqrt(sq / (samples.size() - 1)) : 0.0;
+    s.min_ns = samples.front();
+    s.max_ns = samples.back();
+    s.median_ns = percentile(samples, 0.50);
+    s.p90_ns = percentile(samples, 0.90);
+    s.p99_ns = percentile(samples, 0.99);
+    return s;
+}
+
+// Handed to every benchmark body. The body does its setup, then loops on
+// keepRunning(); the state drives warm-up, calibration and sampling.
+class State {
+public:
+    State(const Config& cfg, long arg) : cfg_(cfg), arg_(arg) {}
+
+    bool keepRunning() {
+        if (remaining_ > 0) {
+            --remaining_;
+            return true;
+        }
+        return nextBatch();
+    }
+
+    // Exclude per-iteration setup (e.g. restoring an input) from the timing
+    void pauseTiming() { accum_ns_ += timer_.elapsed_ns(); }
+    void resumeTiming() { timer_.start(); }
+
+    // Optional throughput reporting, per keepRunning() iteration
+    void setItemsPerIteration(double n) { items_per_iter_ = n; }
+    void setBytesPerIteration(double n) { bytes_per_iter_ = n; }
+
+    // Extra named values reported next to the timings (e.g. accuracy)
+    void setCounter(const std::string& name, double value) {
+        for (auto& c : counters_) {
+            if (c.first == name) {
+                c.second = value;
+                return;
+            }
+        }
+        counters_.emplace_back(name, value);
+    }
+
+    long arg() const { return arg_; }
+
+    const std::vector<double>& samples() const { return samples_; }
+    long batchSize() const { return batch_; }
+    double itemsPerIteration() const { return items_per_iter_; }
+    double bytesPerIteration() const { return bytes_per_iter_; }
+    const std::vector<std::pair<std::string, double>>& counters() const { return counters_; }
+
+private:
+    enum class Phase { Init, Warmup, Measure, Done };
+
+    bool nextBatch() {
+        double elapsed = accum_ns_ + timer_.elapsed_ns();
+        accum_ns_ = 0;
+        switch (phase_) {
+        case Phase::Init:
+            phase_ = Phase::Warmup;
+            batch_ = 1;
+            break;
+        case Phase::Warmup:
+            warm_ns_ += elapsed;
+            warm_iters_ += batch_;
+            if (warm_ns_ < cfg_.warmup_ms * 1e6) {
+                batch_ *= 2;
+            } else {
+                // Calibrate: enough iterations per sample to reach min_sample_ms
+                double per_iter = warm_ns_ / warm_iters_;
+                double want = cfg_.min_sample_ms * 1e6 / std::max(per_iter, 1.0);
+                batch_ = std::max(1L, static_cast<long>(std::ceil(want)));
+                phase_ = Phase::Measure;
+            }
+            break;
+        case Phase::Measure:
+            samples_.push_back(elapsed / batch_);
+            measured_ns_ += elapsed;
+            if (static_cast<int>(samples_.size()) >= cfg_.repetitions ||
+                measured_ns_ > cfg_.max_case_s * 1e9) {
+                phase_ = Phase::Done;
+                return false;
+            }
+            break;
+        case Phase::Done:
+            return false;
+        }
+        remaining_ = batch_ - 1;
+        timer_.start();
+        return true;
+    }
+
+    const Config& cfg_;
+    long arg_;
+    Phase phase_ = Phase::Init;
+    Timer timer_;
+    long remaining_ = 0;
+    long batch_ = 1;
+    double accum_ns_ = 0;
+    double warm_ns_ = 0;
+    long warm_iters_ = 0;
+    double measured_ns_ = 0;
+    double items_per_iter_ = 0;
+    double bytes_per_iter_ = 0;
+    std::vector<double> samples_;
+    std::vector<std::pair<std::string, double>> counters_;
+};
+
+struct Case {
+    std::string name;
+    std::function<void(State&)> fn;
+    long arg;
+};
+
+// Meyers singleton so registration order across translation units is safe
+inline std::vector<Case>& registry() {
+    static std::vector<Case> cases;
+    return cases;
+}
+
+// Registers one case, or one case per argument ("name/arg")
+struct Registrar {
+    Registrar(const std::string& name, std::function<void(State&)> fn) {
+        registry().push_back(Case{name, fn, 0});
+    }
+    Registrar(const std::string& name, std::function<void(State&)> fn,
+              std::initializer_list<long> args) {
+        for (long a : args) {
+            registry().push_back(Case{name + "/" + std::to_string(a), fn, a});
+        }
+    }
+};
+
+}  // namespace bench
+
+#define BENCH_CONCAT_IMPL(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_IMPL(a, b)
+
+// BENCH_CASE("name") { ... }  — body sees `bench::State& state`
+#define BENCH_CASE(name)                                                         \
+    static void BENCH_CONCAT(bench_fn_, __LINE__)(bench::State&);                \
+    static bench::Registrar BENCH_CONCAT(bench_reg_, __LINE__)(                  \
+        name, BENCH_CONCAT(bench_fn_, __LINE__));                                \
+    static void BENCH_CONCAT(bench_fn_, __LINE__)(bench::State & state)
+
+// BENCH_CASE_ARGS("name", 1000, 10000) { ... }  — size via state.arg()
+#define BENCH_CASE_ARGS(name, ...)                                               \
+    static void BENCH_CONCAT(bench_fn_, __LINE__)(bench::State&);                \
+    static bench::Registrar BENCH_CONCAT(bench_reg_, __LINE__)(                  \
+        name, BENCH_CONCAT(bench_fn_, __LINE__), {__VA_ARGS__});                 \
+    static void BENCH_CONCAT(bench_fn_, __LINE__)(bench::State & state)
+
+#endif  // EIGEN_TUTORIAL_BENCH_H
@@ -0,0 +1,286 @@
+/**
+ * Benchmarks: Chapter 1 - Basic Linear Algebra
+ *
+ * Fixed vs dynamic sized products (1.3 / 7.6), norms, point transformation
+ * per point (1.7) and in bulk on SoA clouds (1.8), chained vs fused
+ * reductions (1.6 / 1.9), copying vs mapping pose arrays (1.5 / 1.10)
+ */
+
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "bench/bench.h"
+#include "chapter1/fused_reduction.h"
+#include "chapter1/pose_array_view.h"
+#include "chapter1/soa_transform.h"
+
+BENCH_CASE("ch1/product_fixed_4x4") {
+    Eigen::Matrix4d A = Eigen::Matrix4d::Random();
+    Eigen::Matrix4d B = Eigen::Matrix4d::Random();
+    while (state.keepRunning()) {
+        bench::doNotOptimize(A);
+        Eigen::Matrix4d C = A * B;
+        bench::doNotOptimize(C);
+    }
+}
+
+BENCH_CASE("ch1/product_dynamic_4x4") {
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(4, 4);
+    Eigen::MatrixXd B = Eigen::MatrixXd::Random(4, 4);
+    while (state.keepRunning()) {
+        bench::doNotOptimize(A);
+        Eigen::MatrixXd C = A * B;
+        bench::doNotOptimize(C);
+    }
+}
+
+BENCH_CASE("ch1/matvec_fixed_3x3") {
+    Eigen::Matrix3d R = Eigen::Matrix3d::Random();
+    Eigen::Vector3d p = Eigen::Vector3d::Random();
+    while (state.keepRunning()) {
+        bench::doNotOptimize(p);
+        Eigen::Vector3d q = R * p;
+        bench::doNotOptimize(q);
+    }
+}
+
+BENCH_CASE("ch1/matvec_dynamic_3x3") {
+    Eigen::MatrixXd R = Eigen::MatrixXd::Random(3, 3);
+    Eigen::VectorXd p = Eigen::VectorXd::Random(3);
+    while (state.keepRunning()) {
+        bench::doNotOptimize(p);
+        Eigen::VectorXd q = R * p;
+        bench::doNotOptimize(q);
+    }
+}
+
+BENCH_CASE_ARGS("ch1/product_dynamic_square", 16, 64, 256) {
+    const int n = static_cast<int>(state.arg());
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(n, n);
+    Eigen::MatrixXd B = Eigen::MatrixXd::Random(n, n);
+    Eigen::MatrixXd C(n, n);
+    state.setItemsPerIteration(2.0 * n * n * n);  // flops
+    while (state.keepRunning()) {
+        C.noalias() = A * B;
+        bench::doNotOptimize(C.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch1/norm", 1000, 100000) {
+    Eigen::VectorXd v = Eigen::VectorXd::Random(state.arg());
+    state.setBytesPerIteration(sizeof(double) * state.arg());
+    while (state.keepRunning()) {
+        double n = v.norm();
+        bench::doNotOptimize(n);
+    }
+}
+
+BENCH_CASE_ARGS("ch1/squared_norm", 1000, 100000) {
+    Eigen::VectorXd v = Eigen::VectorXd::Random(state.arg());
+    state.setBytesPerIteration(sizeof(double) * state.arg());
+    while (state.keepRunning()) {
+        double n = v.squaredNorm();
+        bench::doNotOptimize(n);
+    }
+}
+
+// 1.7: p' = R * p + t, one Vector3d at a time over an AoS cloud
+BENCH_CASE_ARGS("ch1/transform_points_aos", 100000, 2000000) {
+    const long n = state.arg();
+    Eigen::Matrix3d R = Eigen::Quaterniond::UnitRandom().toRotationMatrix();
+    Eigen::Vector3d t(1, 2, 3);
+    std::vector<Eigen::Vector3d> pts(n, Eigen::Vector3d::Random());
+    std::vector<Eigen::Vector3d> out(n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        for (long i = 0; i < n; ++i) {
+            out[i] = R * pts[i] + t;
+        }
+        bench::doNotOptimize(out.data());
+        bench::clobberMemory();
+    }
+}
+
+// 1.7: homogeneous Matrix4d * Vector4d per point
+BENCH_CASE_ARGS("ch1/transform_points_homogeneous_4x4", 100000, 2000000) {
+    const long n = state.arg();
+    Eigen::Matrix4d T = Eigen::Matrix4d::Identity();
+    T.block<3,3>(0,0) = Eigen::Quaterniond::UnitRandom().toRotationMatrix();
+    T.block<3,1>(0,3) = Eigen::Vector3d(1, 2, 3);
+    std::vector<Eigen::Vector4d, Eigen::aligned_allocator<Eigen::Vector4d>> pts(
+        n, Eigen::Vector4d(0.1, 0.2, 0.3, 1.0));
+    std::vector<Eigen::Vector4d, Eigen::aligned_allocator<Eigen::Vector4d>> out(n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        for (long i = 0; i < n; ++i) {
+            out[i] = T * pts[i];
+        }
+        bench::doNotOptimize(out.data());
+        bench::clobberMemory();
+    }
+}
+
+namespace {
+
+template <typename Scalar>
+void benchSoaTransform(bench::State& state, int threads) {
+    const Eigen::Index n = state.arg();
+    Eigen::Isometry3d T = Eigen::Isometry3d::Identity();
+    T.rotate(Eigen::Quaterniond::UnitRandom());
+    T.translation() = Eigen::Vector3d(1, 2, 3);
+    eigen_tutorial::PointCloudSoA<Scalar> in(n), out(n);
+    in.x.setRandom();
+    in.y.setRandom();
+    in.z.setRandom();
+    eigen_tutorial::setNumThreads(threads);
+    state.setItemsPerIteration(static_cast<double>(n));
+    state.setBytesPerIteration(6.0 * sizeof(Scalar) * n);
+    while (state.keepRunning()) {
+        eigen_tutorial::transformPoints(T, in, out);
+        bench::doNotOptimize(out.x.data());
+        bench::clobberMemory();
+    }
+    eigen_tutorial::setNumThreads(0);
+}
+
+}  // namespace
+
+BENCH_CASE_ARGS("ch1/transform_points_soa_double_1thread", 100000, 2000000) {
+    benchSoaTransform<double>(state, 1);
+}
+
+BENCH_CASE_ARGS("ch1/transform_points_soa_double", 100000, 2000000) {
+    benchSoaTransform<double>(state, 0);
+}
+
+BENCH_CASE_ARGS("ch1/transform_points_soa_float", 100000, 2000000) {
+    benchSoaTransform<float>(state, 0);
+}
+
+// 1.6: one Eigen reduction per statistic, each one a full pass over memory.
+// Bytes per iteration count the real traffic (7 passes).
+BENCH_CASE_ARGS("ch1/reduce_chained_eigen", 1000000, 16000000) {
+    Eigen::VectorXd v = Eigen::VectorXd::Random(state.arg());
+    state.setItemsPerIteration(static_cast<double>(v.size()));
+    state.setBytesPerIteration(7.0 * sizeof(double) * v.size());
+    while (state.keepRunning()) {
+        Eigen::Index imin, imax;
+        double sum = v.sum();
+        double mean = v.mean();
+        double mn = v.minCoeff();
+        double mx = v.maxCoeff();
+        v.minCoeff(&imin);
+        v.maxCoeff(&imax);
+        double var = (v.array() - mean).square().mean();
+        bench::doNotOptimize(sum);
+        bench::doNotOptimize(mn);
+        bench::doNotOptimize(mx);
+        bench::doNotOptimize(imin);
+        bench::doNotOptimize(imax);
+        bench::doNotOptimize(var);
+    }
+}
+
+BENCH_CASE_ARGS("ch1/reduce_fused_all", 1000000, 16000000) {
+    Eigen::VectorXd v = Eigen::VectorXd::Random(state.arg());
+    state.setItemsPerIteration(static_cast<double>(v.size()));
+    state.setBytesPerIteration(sizeof(double) * v.size());
+    while (state.keepRunning()) {
+        eigen_tutorial::ReductionStats s = eigen_tutorial::fusedReduce(v);
+        bench::doNotOptimize(s);
+    }
+}
+
+BENCH_CASE_ARGS("ch1/reduce_fused_mean_variance", 1000000, 16000000) {
+    Eigen::VectorXd v = Eigen::VectorXd::Random(state.arg());
+    state.setItemsPerIteration(static_cast<double>(v.size()));
+    state.setBytesPerIteration(sizeof(double) * v.size());
+    while (state.keepRunning()) {
+        eigen_tutorial::ReductionStats s = eigen_tutorial::fusedReduce(
+            v, eigen_tutorial::kReduceMean | eigen_tutorial::kReduceVariance);
+        bench::doNotOptimize(s);
+    }
+}
+
+namespace {
+
+std::vector<double> randomPoseLog(long n) {
+    std::vector<double> buffer(16 * n);
+    for (long i = 0; i < n; ++i) {
+        Eigen::Matrix4d T = Eigen::Matrix4d::Identity();
+        T.block<3,3>(0,0) = Eigen::Quaterniond::UnitRandom().toRotationMatrix();
+        T.block<3,1>(0,3) = Eigen::Vector3d::Random();
+        Eigen::Map<Eigen::Matrix<double, 4, 4, Eigen::RowMajor>> slot(&buffer[16 * i]);
+        slot = T;
+    }
+    return buffer;
+}
+
+}  // namespace
+
+// 1.5 style: load the log into Matrix4d objects, then block<3,3>() * v
+BENCH_CASE_ARGS("ch1/pose_log_rotate_copy", 100000, 1000000) {
+    const long n = state.arg();
+    std::vector<double> buffer = randomPoseLog(n);
+    Eigen::Vector3d v(0.3, -0.2, 0.9);
+    Eigen::Matrix<double, 3, Eigen::Dynamic> out(3, n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        std::vector<Eigen::Matrix4d, Eigen::aligned_allocator<Eigen::Matrix4d>> poses(n);
+        for (long i = 0; i < n; ++i) {
+            poses[i] = Eigen::Map<const Eigen::Matrix<double, 4, 4, Eigen::RowMajor>>(&buffer[16 * i]);
+        }
+        for (long i = 0; i < n; ++i) {
+            out.col(i) = poses[i].block<3,3>(0,0) * v;
+        }
+        bench::doNotOptimize(out.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch1/pose_log_rotate_view", 100000, 1000000) {
+    const long n = state.arg();
+    std::vector<double> buffer = randomPoseLog(n);
+    eigen_tutorial::PoseArrayView4<const double> view(buffer.data(), n);
+    Eigen::Vector3d v(0.3, -0.2, 0.9);
+    Eigen::Matrix<double, 3, Eigen::Dynamic> out(3, n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        view.rotate(v, out);
+        bench::doNotOptimize(out.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch1/pose_log_translations_copy", 100000, 1000000) {
+    const long n = state.arg();
+    std::vector<double> buffer = randomPoseLog(n);
+    eigen_tutorial::PointCloudSoA<double> out(n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        std::vector<Eigen::Matrix4d, Eigen::aligned_allocator<Eigen::Matrix4d>> poses(n);
+        for (long i = 0; i < n; ++i) {
+            poses[i] = Eigen::Map<const Eigen::Matrix<double, 4, 4, Eigen::RowMajor>>(&buffer[16 * i]);
+        }
+        for (long i = 0; i < n; ++i) {
+            out.setPoint(i, poses[i].block<3,1>(0,3));
+        }
+        bench::doNotOptimize(out.x.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch1/pose_log_translations_view", 100000, 1000000) {
+    const long n = state.arg();
+    std::vector<double> buffer = randomPoseLog(n);
+    eigen_tutorial::PoseArrayView4<const double> view(buffer.data(), n);
+    eigen_tutorial::PointCloudSoA<double> out(n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        view.translationsToSoA(out);
+        bench::doNotOptimize(out.x.data());
+        bench::clobberMemory();
+    }
+}
@@ -0,0 +1,582 @@
+/**
+ * Benchmarks: Chapter 2 - Matrix Decompositions
+ *
+ * SVD, QR, Cholesky, LU and symmetric eigen-decomposition at the sizes the
+ * chapter uses (3x3) and at a moderate dynamic size, plus the batched 3x3
+ * SVD of 2.8 against a JacobiSVD loop over the same batch and the closed-form
+ * symmetric eigen-solver of 2.9 against SelfAdjointEigenSolver, and the
+ * streaming Procrustes accumulator of 2.10 against 2.2's centered copies,
+ * and one ICP iteration (2.11) on synthetic scans of 10k to 5M points, and
+ * voxel-grid downsampling (2.12) of 1M / 10M-point scans, and KD-tree (2.13)
+ * build and batched k-NN / radius queries on 1M-point scans, and Gaussian
+ * sampling (2.14) against a std::normal_distribution loop, and the five-point
+ * solver and essential-matrix RANSAC (2.15) on 2k correspondences, and the
+ * randomized truncated SVD (2.16) against BDCSVD on large square matrices
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "bench/bench.h"
+#include "chapter2/batched_svd3.h"
+#include "chapter2/five_point.h"
+#include "chapter2/gaussian_sampler.h"
+#include "chapter2/icp.h"
+#include "chapter2/kd_tree.h"
+#include "chapter2/procrustes_accumulator.h"
+#include "chapter2/randomized_svd.h"
+#include "chapter2/sym_eigen3.h"
+#include "chapter2/voxel_downsample.h"
+
+namespace {
+
+Eigen::MatrixXd randomSpd(int n) {
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(n, n);
+    return A * A.transpose() + n * Eigen::MatrixXd::Identity(n, n);
+}
+
+// Batch of independent random 3x3 matrices
+std::vector<Eigen::Matrix3d> randomMatrices3(size_t n) {
+    std::vector<Eigen::Matrix3d> A(n);
+    for (Eigen::Matrix3d& a : A) a = Eigen::Matrix3d::Random();
+    return A;
+}
+
+const size_t kSvdBatch = 100000;
+
+// Neighbourhood covariances for normal estimation: half random, half flat
+// discs (two nearly equal eigenvalues, the hard case for closed forms)
+std::vector<Eigen::Matrix3d> randomCovariances(size_t n) {
+    std::vector<Eigen::Matrix3d> C(n);
+    for (size_t m = 0; m < n; ++m) {
+        if (m % 2 == 0) {
+            Eigen::Matrix3d A = Eigen::Matrix3d::Random();
+            C[m] = A * A.transpose();
+        } else {
+            Eigen::Matrix3d R = Eigen::Quaterniond::UnitRandom().toRotationMatrix();
+            C[m] = R * Eigen::Vector3d(0.01, 1.0, 1.0 + 1e-9).asDiagonal() * R.transpose();
+        }
+    }
+    return C;
+}
+
+double maxEigenResidual(const std::vector<Eigen::Matrix3d>& C, const std::vector<Eigen::Vector3d>& l,
+                        const std::vector<Eigen::Matrix3d>& V) {
+    double res = 0;
+    for (size_t m = 0; m < C.size(); ++m) {
+        res = std::max(res, (C[m] * V[m] - V[m] * l[m].asDiagonal()).norm() / C[m].norm());
+    }
+    return res;
+}
+
+// Walls, floor and ceiling of a box room sampled at ~400 points / m^2; the
+// room grows with n so that density (and work per query) stays realistic
+Eigen::Matrix3Xd roomScan(Eigen::Index n, unsigned seed) {
+    const double size = std::sqrt(n / 400.0 / 6.0);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> u(0.0, size);
+    Eigen::Matrix3Xd P(3, n);
+    for (Eigen::Index i = 0; i < n; ++i) {
+        const double a = u(rng), b = u(rng);
+        const double side = (i % 2) ? size : 0.0;
+        switch ((i / 2) % 3) {
+            case 0: P.col(i) << a, b, side; break;
+            case 1: P.col(i) << side, a, b; break;
+            default: P.col(i) << a, side, b;
+        }
+    }
+    return P;
+}
+
+// The covariance of 2.4
+Eigen::Matrix3d samplerCovariance() {
+    Eigen::Matrix3d cov;
+    cov << 4, 2, 1,
+           2, 5, 2,
+           1, 2, 6;
+    return cov;
+}
+
+// Normalized image matches of a static scene seen from two poses (500 px
+// focal, 0.5 px noise); every k-th match is replaced by a random one
+void twoViewMatches(int n, int outlier_every, Eigen::Matrix2Xd& x1, Eigen::Matrix2Xd& x2) {
+    const Eigen::Matrix3d R = Eigen::AngleAxisd(0.08, Eigen::Vector3d(0.1, 1, 0.05).normalized()).toRotationMatrix();
+    const Eigen::Vector3d t = Eigen::Vector3d(0.3, 0.05, -1).normalized();
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    std::normal_distribution<double> noise(0.0, 0.5 / 500);
+    x1.resize(2, n);
+    x2.resize(2, n);
+    for (int i = 0; i < n; ++i) {
+        const Eigen::Vector3d X(8 * u(rng), 6 * u(rng), 12 + 8 * u(rng));
+        x1.col(i) = X.hnormalized() + Eigen::Vector2d(noise(rng), noise(rng));
+        x2.col(i) = (R * X + t).hnormalized() + Eigen::Vector2d(noise(rng), noise(rng));
+        if (outlier_every > 0 && i % outlier_every == 0) x2.col(i) << 0.6 * u(rng), 0.45 * u(rng);
+    }
+}
+
+// Rank-20 signal plus noise, the shape of a gauge-deficient information matrix
+Eigen::MatrixXd lowRankSquare(Eigen::Index n) {
+    Eigen::MatrixXd L = Eigen::MatrixXd::Random(n, 20);
+    return L * L.transpose() + 1e-6 * Eigen::MatrixXd::Random(n, n);
+}
+
+}  // namespace
+
+BENCH_CASE("ch2/jacobi_svd_3x3") {
+    Eigen::Matrix3d H = Eigen::Matrix3d::Random();
+    while (state.keepRunning()) {
+        bench::doNotOptimize(H);
+        Eigen::JacobiSVD<Eigen::Matrix3d> svd(H, Eigen::ComputeFullU | Eigen::ComputeFullV);
+        bench::doNotOptimize(svd.matrixU());
+        bench::doNotOptimize(svd.matrixV());
+    }
+}
+
+// Same work as ch2/batched_svd3 (full U, S, V for every matrix of the batch)
+BENCH_CASE("ch2/jacobi_svd_3x3_batch") {
+    std::vector<Eigen::Matrix3d> A = randomMatrices3(kSvdBatch), U(kSvdBatch), V(kSvdBatch);
+    std::vector<Eigen::Vector3d> S(kSvdBatch);
+    state.setItemsPerIteration(kSvdBatch);
+    while (state.keepRunning()) {
+        for (size_t m = 0; m < kSvdBatch; ++m) {
+            Eigen::JacobiSVD<Eigen::Matrix3d> svd(A[m], Eigen::ComputeFullU | Eigen::ComputeFullV);
+            U[m] = svd.matrixU();
+            S[m] = svd.singularValues();
+            V[m] = svd.matrixV();
+        }
+        bench::clobberMemory();
+    }
+}
+
+// Argument = Jacobi sweeps; max_rel_err = worst |sigma_i - JacobiSVD| / sigma_0
+BENCH_CASE_ARGS("ch2/batched_svd3", 3, 4, 5, 6) {
+    const int sweeps = static_cast<int>(state.arg());
+    std::vector<Eigen::Matrix3d> A = randomMatrices3(kSvdBatch), U(kSvdBatch), V(kSvdBatch);
+    std::vector<Eigen::Vector3d> S(kSvdBatch);
+    state.setItemsPerIteration(kSvdBatch);
+    while (state.keepRunning()) {
+        eigen_tutorial::batchedSvd3(A.data(), kSvdBatch, U.data(), S.data(), V.data(), sweeps);
+        bench::clobberMemory();
+    }
+    double err = 0;
+    for (size_t m = 0; m < kSvdBatch; ++m) {
+        Eigen::Vector3d ref = Eigen::JacobiSVD<Eigen::Matrix3d>(A[m]).singularValues();
+        Eigen::Vector3d s(S[m](0), S[m](1), std::abs(S[m](2)));
+        err = std::max(err, (s - ref).cwiseAbs().maxCoeff() / ref(0));
+    }
+    state.setCounter("max_rel_err", err);
+}
+
+BENCH_CASE_ARGS("ch2/batched_svd3_float", 4) {
+    const int sweeps = static_cast<int>(state.arg());
+    std::vector<Eigen::Matrix3f> A(kSvdBatch), U(kSvdBatch), V(kSvdBatch);
+    std::vector<Eigen::Vector3f> S(kSvdBatch);
+    for (Eigen::Matrix3f& a : A) a = Eigen::Matrix3f::Random();
+    state.setItemsPerIteration(kSvdBatch);
+    while (state.keepRunning()) {
+        eigen_tutorial::batchedSvd3(A.data(), kSvdBatch, U.data(), S.data(), V.data(), sweeps);
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch2/jacobi_svd_dynamic", 20, 100) {
+    const int n = static_cast<int>(state.arg());
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(n, n);
+    while (state.keepRunning()) {
+        Eigen::JacobiSVD<Eigen::MatrixXd> svd(A, Eigen::ComputeThinU | Eigen::ComputeThinV);
+        bench::doNotOptimize(svd.singularValues().data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch2/bdc_svd_dynamic", 20, 100) {
+    const int n = static_cast<int>(state.arg());
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(n, n);
+    while (state.keepRunning()) {
+        Eigen::BDCSVD<Eigen::MatrixXd> svd(A, Eigen::ComputeThinU | Eigen::ComputeThinV);
+        bench::doNotOptimize(svd.singularValues().data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch2/householder_qr_tall", 1000, 100000) {
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(state.arg(), 6);
+    while (state.keepRunning()) {
+        Eigen::HouseholderQR<Eigen::MatrixXd> qr(A);
+        bench::doNotOptimize(qr.matrixQR().data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE("ch2/llt_3x3") {
+    Eigen::Matrix3d A = randomSpd(3);
+    while (state.keepRunning()) {
+        bench::doNotOptimize(A);
+        Eigen::LLT<Eigen::Matrix3d> llt(A);
+        bench::doNotOptimize(llt.matrixLLT());
+    }
+}
+
+BENCH_CASE_ARGS("ch2/llt_dynamic", 50, 200) {
+    Eigen::MatrixXd A = randomSpd(static_cast<int>(state.arg()));
+    while (state.keepRunning()) {
+        Eigen::LLT<Eigen::MatrixXd> llt(A);
+        bench::doNotOptimize(llt.matrixLLT().data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE("ch2/partial_piv_lu_3x3") {
+    Eigen::Matrix3d A = Eigen::Matrix3d::Random() + 3 * Eigen::Matrix3d::Identity();
+    while (state.keepRunning()) {
+        bench::doNotOptimize(A);
+        Eigen::PartialPivLU<Eigen::Matrix3d> lu(A);
+        bench::doNotOptimize(lu.matrixLU());
+    }
+}
+
+BENCH_CASE_ARGS("ch2/partial_piv_lu_dynamic", 50, 200) {
+    const int n = static_cast<int>(state.arg());
+    Eigen::MatrixXd A = Eigen::MatrixXd::Random(n, n) + n * Eigen::MatrixXd::Identity(n, n);
+    while (state.keepRunning()) {
+        Eigen::PartialPivLU<Eigen::MatrixXd> lu(A);
+        bench::doNotOptimize(lu.matrixLU().data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE("ch2/self_adjoint_eigen_3x3") {
+    Eigen::Matrix3d C = randomSpd(3);
+    while (state.keepRunning()) {
+        bench::doNotOptimize(C);
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> es(C);
+        bench::doNotOptimize(es.eigenvectors());
+    }
+}
+
+BENCH_CASE("ch2/self_adjoint_eigen_3x3_batch") {
+    std::vector<Eigen::Matrix3d> C = randomCovariances(kSvdBatch), V(kSvdBatch);
+    std::vector<Eigen::Vector3d> l(kSvdBatch);
+    state.setItemsPerIteration(kSvdBatch);
+    while (state.keepRunning()) {
+        for (size_t m = 0; m < kSvdBatch; ++m) {
+            Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> es(C[m]);
+            l[m] = es.eigenvalues();
+            V[m] = es.eigenvectors();
+        }
+        bench::clobberMemory();
+    }
+    state.setCounter("max_residual", maxEigenResidual(C, l, V));
+}
+
+// Eigen's own closed form (no fallback, single thread) for reference
+BENCH_CASE("ch2/self_adjoint_eigen_direct_3x3_batch") {
+    std::vector<Eigen::Matrix3d> C = randomCovariances(kSvdBatch), V(kSvdBatch);
+    std::vector<Eigen::Vector3d> l(kSvdBatch);
+    state.setItemsPerIteration(kSvdBatch);
+    while (state.keepRunning()) {
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> es;
+        for (size_t m = 0; m < kSvdBatch; ++m) {
+            es.computeDirect(C[m]);
+            l[m] = es.eigenvalues();
+            V[m] = es.eigenvectors();
+        }
+        bench::clobberMemory();
+    }
+    state.setCounter("max_residual", maxEigenResidual(C, l, V));
+}
+
+// max_residual = worst ||C V - V diag(l)|| / ||C||
+BENCH_CASE("ch2/batched_sym_eigen3") {
+    std::vector<Eigen::Matrix3d> C = randomCovariances(kSvdBatch), V(kSvdBatch);
+    std::vector<Eigen::Vector3d> l(kSvdBatch);
+    state.setItemsPerIteration(kSvdBatch);
+    while (state.keepRunning()) {
+        eigen_tutorial::batchedSymEigen3(C.data(), kSvdBatch, l.data(), V.data());
+        bench::clobberMemory();
+    }
+    state.setCounter("max_residual", maxEigenResidual(C, l, V));
+}
+
+// 2.2: centroids, centered copies, dense product, SVD
+BENCH_CASE_ARGS("ch2/procrustes_centered_copies", 100000, 1000000) {
+    const Eigen::Index n = state.arg();
+    Eigen::Matrix3Xd P = Eigen::Matrix3Xd::Random(3, n);
+    Eigen::Matrix3Xd Q = P + 0.01 * Eigen::Matrix3Xd::Random(3, n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    state.setBytesPerIteration(2.0 * 3 * n * sizeof(double));
+    while (state.keepRunning()) {
+        Eigen::Vector3d cp = P.rowwise().mean(), cq = Q.rowwise().mean();
+        Eigen::MatrixXd P_centered = P.colwise() - cp;
+        Eigen::MatrixXd Q_centered = Q.colwise() - cq;
+        Eigen::Matrix3d H = P_centered * Q_centered.transpose();
+        Eigen::JacobiSVD<Eigen::Matrix3d> svd(H, Eigen::ComputeFullU | Eigen::ComputeFullV);
+        Eigen::Matrix3d R = svd.matrixV() * svd.matrixU().transpose();
+        bench::doNotOptimize(R);
+    }
+}
+
+BENCH_CASE_ARGS("ch2/procrustes_streaming_1thread", 100000, 1000000) {
+    const Eigen::Index n = state.arg();
+    Eigen::Matrix3Xd P = Eigen::Matrix3Xd::Random(3, n);
+    Eigen::Matrix3Xd Q = P + 0.01 * Eigen::Matrix3Xd::Random(3, n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    state.setBytesPerIteration(2.0 * 3 * n * sizeof(double));
+    while (state.keepRunning()) {
+        eigen_tutorial::ProcrustesAccumulator acc;
+        acc.addColumns(P, Q);
+        Eigen::Matrix3d R;
+        Eigen::Vector3d t;
+        acc.solve(R, t);
+        bench::doNotOptimize(R);
+    }
+}
+
+BENCH_CASE_ARGS("ch2/procrustes_streaming", 100000, 1000000) {
+    const Eigen::Index n = state.arg();
+    Eigen::Matrix3Xd P = Eigen::Matrix3Xd::Random(3, n);
+    Eigen::Matrix3Xd Q = P + 0.01 * Eigen::Matrix3Xd::Random(3, n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    state.setBytesPerIteration(2.0 * 3 * n * sizeof(double));
+    while (state.keepRunning()) {
+        Eigen::Matrix3d R;
+        Eigen::Vector3d t;
+        eigen_tutorial::accumulateProcrustes(P, Q).solve(R, t);
+        bench::doNotOptimize(R);
+    }
+}
+
+// align() with a fixed 5 iterations (no convergence test). items/s counts
+// correspondence searches; iteration_ms = time per ICP iteration, with the
+// once-per-align() Z-order sort of the source spread over the 5 iterations
+void icpIterationCase(bench::State& state, eigen_tutorial::IcpMetric metric) {
+    const int iterations = 5;
+    const Eigen::Index n = state.arg();
+    Eigen::Matrix3Xd target = roomScan(n, 1);
+    Eigen::Isometry3d T = Eigen::Isometry3d::Identity();
+    T.linear() = Eigen::AngleAxisd(0.02, Eigen::Vector3d::UnitZ()).toRotationMatrix();
+    T.translation() << 0.05, -0.03, 0.02;
+    Eigen::Matrix3Xd source = T * roomScan(n, 2);
+
+    eigen_tutorial::IcpOptions options;
+    options.metric = metric;
+    options.max_iterations = iterations;
+    options.rotation_tolerance = 0;
+    options.translation_tolerance = 0;
+    options.max_correspondence_distance = 0.25;
+    eigen_tutorial::Icp icp(options);
+    icp.setTarget(target);
+    state.setItemsPerIteration(static_cast<double>(n) * iterations);
+    double total_ms = 0;
+    long runs = 0;
+    while (state.keepRunning()) {
+        auto t0 = std::chrono::steady_clock::now();
+        eigen_tutorial::IcpResult r = icp.align(source);
+        total_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        ++runs;
+        bench::doNotOptimize(r.rmse);
+    }
+    state.setCounter("iteration_ms", total_ms / (runs * iterations));
+}
+
+BENCH_CASE_ARGS("ch2/icp_iteration_point_to_point", 10000, 100000, 1000000, 5000000) {
+    icpIterationCase(state, eigen_tutorial::IcpMetric::kPointToPoint);
+}
+
+BENCH_CASE_ARGS("ch2/icp_iteration_point_to_plane", 10000, 100000, 1000000, 5000000) {
+    icpIterationCase(state, eigen_tutorial::IcpMetric::kPointToPlane);
+}
+
+// items/s = input points per second; voxels = output size at 10 cm (~4 points per voxel)
+void voxelDownsampleCase(bench::State& state, eigen_tutorial::VoxelReduction mode) {
+    const Eigen::Index n = state.arg();
+    Eigen::Matrix3Xd scan = roomScan(n, 1);
+    state.setItemsPerIteration(static_cast<double>(n));
+    Eigen::Index kept = 0;
+    while (state.keepRunning()) {
+        Eigen::Matrix3Xd out = eigen_tutorial::voxelDownsample(scan, 0.1, mode);
+        kept = out.cols();
+        bench::doNotOptimize(out.data());
+    }
+    state.setCounter("voxels", static_cast<double>(kept));
+}
+
+BENCH_CASE_ARGS("ch2/voxel_downsample_centroid", 1000000, 10000000) {
+    voxelDownsampleCase(state, eigen_tutorial::VoxelReduction::kCentroid);
+}
+
+BENCH_CASE_ARGS("ch2/voxel_downsample_first", 1000000, 10000000) {
+    voxelDownsampleCase(state, eigen_tutorial::VoxelReduction::kFirstPoint);
+}
+
+// Steady-state insertion of 100k-point scans into a map that is kept local
+BENCH_CASE_ARGS("ch2/voxel_map_insert", 100000) {
+    const Eigen::Index n = state.arg();
+    Eigen::Matrix3Xd scan = roomScan(n, 1);
+    eigen_tutorial::VoxelMap map(0.1);
+    Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        pose.translation().x() += 0.1;
+        map.insert(scan, pose);
+        map.pruneOutside(pose.translation(), 20.0);
+        bench::doNotOptimize(map.size());
+    }
+}
+
+BENCH_CASE_ARGS("ch2/kd_tree_build", 1000000, 5000000) {
+    const Eigen::Index n = state.arg();
+    Eigen::Matrix3Xd scan = roomScan(n, 1);
+    eigen_tutorial::KdTree3d tree;
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        tree.build(scan);
+        bench::doNotOptimize(tree.points().data());
+    }
+}
+
+// 100k queries against a 1M-point tree; items/s = queries. Argument = k for
+// exact search, k + 1000 for approximate search with eps = 1
+BENCH_CASE_ARGS("ch2/kd_tree_knn_batch", 1, 10, 1010) {
+    const int k = static_cast<int>(state.arg() % 1000);
+    const double eps = state.arg() >= 1000 ? 1.0 : 0.0;
+    eigen_tutorial::KdTree3d tree(roomScan(1000000, 1));
+    // A second scan of the same room, so queries lie on the surfaces
+    Eigen::Matrix3Xd queries = roomScan(1000000, 2).leftCols(100000);
+    eigen_tutorial::KdTree3d::IndexMatrix idx;
+    eigen_tutorial::KdTree3d::DistanceMatrix d2;
+    state.setItemsPerIteration(static_cast<double>(queries.cols()));
+    while (state.keepRunning()) {
+        tree.knnBatch(queries, k, idx, d2, eps);
+        bench::doNotOptimize(idx.data());
+    }
+}
+
+BENCH_CASE_ARGS("ch2/kd_tree_radius_batch", 100000) {
+    eigen_tutorial::KdTree3d tree(roomScan(1000000, 1));
+    Eigen::Matrix3Xd queries = roomScan(1000000, 2).leftCols(state.arg());
+    eigen_tutorial::NeighborLists<double> lists;
+    state.setItemsPerIteration(static_cast<double>(queries.cols()));
+    while (state.keepRunning()) {
+        tree.radiusBatch(queries, 0.1, lists);
+        bench::doNotOptimize(lists.indices.data());
+    }
+    state.setCounter("neighbours_per_query", double(lists.indices.size()) / queries.cols());
+}
+
+// items/s = 3-D samples per second, 1M per iteration
+BENCH_CASE("ch2/gaussian_sample_std_normal") {
+    const Eigen::Index n = 1000000;
+    const Eigen::Matrix3d L = samplerCovariance().llt().matrixL();
+    std::mt19937_64 rng(1);
+    std::normal_distribution<double> normal;
+    Eigen::Matrix3Xd X(3, n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        for (Eigen::Index i = 0; i < n; ++i) X.col(i) = L * Eigen::Vector3d(normal(rng), normal(rng), normal(rng));
+        bench::doNotOptimize(X.data());
+    }
+}
+
+BENCH_CASE("ch2/gaussian_sampler") {
+    const size_t n = 1000000;
+    eigen_tutorial::GaussianSampler<double, 3> sampler(Eigen::Vector3d::Zero(), samplerCovariance());
+    Eigen::Matrix3Xd X(3, n);
+    uint64_t stream = 0;
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        sampler.sample(X.data(), n, stream++);
+        bench::doNotOptimize(X.data());
+    }
+}
+
+BENCH_CASE("ch2/gaussian_sampler_float_6d") {
+    const size_t n = 1000000;
+    Eigen::Matrix<float, 6, 6> Q = Eigen::Matrix<float, 6, 6>::Identity();
+    Q(0, 5) = Q(5, 0) = 0.5f;
+    eigen_tutorial::GaussianSampler<float, 6> sampler(Eigen::Matrix<float, 6, 1>::Zero(), Q);
+    Eigen::Matrix<float, 6, Eigen::Dynamic> X(6, n);
+    uint64_t stream = 0;
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        sampler.sample(X.data(), n, stream++);
+        bench::doNotOptimize(X.data());
+    }
+}
+
+BENCH_CASE("ch2/five_point_solve") {
+    Eigen::Matrix2Xd x1, x2;
+    twoViewMatches(5, 0, x1, x2);
+    const Eigen::Matrix<double, 2, 5> a = x1, b = x2;
+    Eigen::Matrix3d E[10];
+    while (state.keepRunning()) {
+        bench::doNotOptimize(eigen_tutorial::fivePoint(a, b, E));
+        bench::clobberMemory();
+    }
+}
+
+// One estimate on 2000 matches, argument = every k-th match is an outlier
+// (2 -> 50%, 4 -> 25%). samples = minimal samples needed by the adaptive
+// stopping rule
+BENCH_CASE_ARGS("ch2/essential_ransac_preemptive", 2, 4) {
+    Eigen::Matrix2Xd x1, x2;
+    twoViewMatches(2000, static_cast<int>(state.arg()), x1, x2);
+    eigen_tutorial::EssentialRansacOptions options;
+    options.threshold = 1.5 / 500;
+    eigen_tutorial::EssentialRansac ransac(options);
+    eigen_tutorial::EssentialResult r;
+    while (state.keepRunning()) {
+        r = ransac.estimate(x1, x2);
+        bench::doNotOptimize(r.E);
+    }
+    state.setCounter("samples", r.samples);
+    state.setCounter("inliers", static_cast<double>(r.num_inliers));
+}
+
+BENCH_CASE_ARGS("ch2/essential_ransac_full_scoring", 2, 4) {
+    Eigen::Matrix2Xd x1, x2;
+    twoViewMatches(2000, static_cast<int>(state.arg()), x1, x2);
+    eigen_tutorial::EssentialRansacOptions options;
+    options.threshold = 1.5 / 500;
+    options.preemptive_block = 0;
+    eigen_tutorial::EssentialRansac ransac(options);
+    eigen_tutorial::EssentialResult r;
+    while (state.keepRunning()) {
+        r = ransac.estimate(x1, x2);
+        bench::doNotOptimize(r.E);
+    }
+    state.setCounter("samples", r.samples);
+    state.setCounter("inliers", static_cast<double>(r.num_inliers));
+}
+
+BENCH_CASE_ARGS("ch2/bdc_svd_large", 1000) {
+    Eigen::MatrixXd A = lowRankSquare(state.arg());
+    while (state.keepRunning()) {
+        Eigen::BDCSVD<Eigen::MatrixXd> svd(A, Eigen::ComputeThinU | Eigen::ComputeThinV);
+        bench::doNotOptimize(svd.singularValues().data());
+    }
+}
+
+// k = 20, p = 10, q = 2; max_rel_err = worst |sigma_i - BDCSVD| / sigma_0 (n = 1000 only)
+BENCH_CASE_ARGS("ch2/randomized_svd", 1000, 2000, 4000) {
+    const Eigen::Index n = state.arg();
+    Eigen::MatrixXd A = lowRankSquare(n);
+    eigen_tutorial::RandomizedSvdOptions options;
+    options.rank = 20;
+    eigen_tutorial::RandomizedSvd svd;
+    state.setBytesPerIteration(static_cast<double>(n * n * sizeof(double)) * 2 * (options.power_iterations + 1));
+    while (state.keepRunning()) {
+        svd.compute(A, options);
+        bench::doNotOptimize(svd.singularValues().data());
+    }
+    if (n == 1000) {
+        Eigen::VectorXd exact = Eigen::BDCSVD<Eigen::MatrixXd>(A).singularValues().head(20);
+        state.setCounter("max_rel_err", (svd.singularValues() - exact).cwiseAbs().maxCoeff() / exact(0));
+    }
+}
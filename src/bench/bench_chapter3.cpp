@@ -0,0 +1,424 @@
+/**
+ * Benchmarks: Chapter 3 - Geometry Module
+ *
+ * Transform chains (3.9) applied link by link vs fused once (3.11),
+ * SO3 / SE3 exp / log / composition (3.12) vs AngleAxisd / Isometry3d, and
+ * transform-tree lookups (3.13): walking the parent chain vs cached root
+ * transforms, alone and against a concurrent writer, and batched SoA
+ * rotation conversions (3.14) vs Eigen one rotation at a time
+ */
+
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "bench/bench.h"
+#include "chapter3/lie_group.h"
+#include "chapter3/rotation_batch.h"
+#include "chapter3/transform_chain.h"
+#include "chapter3/transform_tree.h"
+
+namespace {
+
+const int kChainLength = 4;
+
+std::vector<Eigen::Isometry3d, Eigen::aligned_allocator<Eigen::Isometry3d>> randomChain() {
+    std::vector<Eigen::Isometry3d, Eigen::aligned_allocator<Eigen::Isometry3d>> links;
+    for (int k = 0; k < kChainLength; ++k) {
+        Eigen::Isometry3d T = Eigen::Isometry3d::Identity();
+        T.rotate(Eigen::Quaterniond::UnitRandom());
+        T.translation() = Eigen::Vector3d::Random();
+        links.push_back(T);
+    }
+    return links;
+}
+
+const int kTangents = 4096;
+
+// [rho; phi] with angles up to ~1.7 rad, a few of them tiny
+std::vector<eigen_tutorial::SE3d::Tangent> randomTangents() {
+    std::vector<eigen_tutorial::SE3d::Tangent> xi(kTangents);
+    for (int i = 0; i < kTangents; ++i) {
+        xi[i].setRandom();
+        if (i % 16 == 0) xi[i].tail<3>() *= 1e-6;
+    }
+    return xi;
+}
+
+// world -> odom -> base -> {8 sensors, 6-link arm}; lookups between the
+// sensors and the arm tip, as a perception pipeline would issue them
+struct FrameTree {
+    std::vector<int> parent;
+    std::vector<Eigen::Isometry3d, Eigen::aligned_allocator<Eigen::Isometry3d>> links;
+    std::vector<std::pair<int, int>> queries;
+    eigen_tutorial::TransformTreed tree{32};
+
+    FrameTree() {
+        parent.push_back(-1);
+        links.push_back(Eigen::Isometry3d::Identity());
+        add(0);                                      // odom
+        add(1);                                      // base
+        for (int s = 0; s < 8; ++s) add(2);          // sensors 3..10
+        for (int k = 0; k < 6; ++k) add(k == 0 ? 2 : static_cast<int>(parent.size()) - 1);  // arm 11..16
+        for (int s = 3; s <= 10; ++s) {
+            queries.push_back(std::make_pair(s, 16));
+            queries.push_back(std::make_pair(0, s));
+        }
+    }
+
+    void add(int p) {
+        Eigen::Isometry3d T = Eigen::Isometry3d::Identity();
+        T.rotate(Eigen::Quaterniond::UnitRandom());
+        T.translation() = Eigen::Vector3d::Random();
+        parent.push_back(p);
+        links.push_back(T);
+        tree.addFrame(p, T);
+    }
+
+    // T_root_frame by walking up the parents
+    Eigen::Isometry3d walk(int frame) const {
+        Eigen::Isometry3d T = Eigen::Isometry3d::Identity();
+        for (int f = frame; f > 0; f = parent[f]) T = links[f] * T;
+        return T;
+    }
+};
+
+const int kTreeLookups = 1024;
+
+// Rotation matrices as 9 SoA columns plus quaternion / rotation vector columns
+struct RotationColumns {
+    std::vector<double> m[9], q[4], v[3];
+    std::vector<Eigen::Matrix3d> matrices;
+    std::vector<Eigen::Quaterniond> quaternions;
+
+    explicit RotationColumns(size_t n) : matrices(n), quaternions(n) {
+        for (auto& c : m) c.resize(n);
+        for (auto& c : q) c.resize(n);
+        for (auto& c : v) c.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            quaternions[i] = Eigen::Quaterniond::UnitRandom();
+            matrices[i] = quaternions[i].toRotationMatrix();
+            for (int k = 0; k < 9; ++k) m[k][i] = matrices[i](k / 3, k % 3);
+            q[0][i] = quaternions[i].w();
+            q[1][i] = quaternions[i].x();
+            q[2][i] = quaternions[i].y();
+            q[3][i] = quaternions[i].z();
+        }
+    }
+
+    eigen_tutorial::RotationMatrices<double> matrixView() {
+        eigen_tutorial::RotationMatrices<double> r;
+        for (int k = 0; k < 9; ++k) r.m[k] = m[k].data();
+        return r;
+    }
+    eigen_tutorial::Quaternions<double> quaternionView() {
+        return eigen_tutorial::Quaternions<double>{q[0].data(), q[1].data(), q[2].data(), q[3].data()};
+    }
+    eigen_tutorial::RotationVectors<double> rotationVectorView() {
+        return eigen_tutorial::RotationVectors<double>{v[0].data(), v[1].data(), v[2].data()};
+    }
+};
+
+}  // namespace
+
+// K Isometry3d products per point, innermost link first
+BENCH_CASE_ARGS("ch3/chain_apply_per_link", 100000, 1000000) {
+    const long n = state.arg();
+    auto links = randomChain();
+    std::vector<Eigen::Vector3d> pts(n, Eigen::Vector3d(0.1, 0.2, 0.3));
+    std::vector<Eigen::Vector3d> out(n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        for (long i = 0; i < n; ++i) {
+            Eigen::Vector3d p = pts[i];
+            for (int k = kChainLength - 1; k >= 0; --k) p = links[k] * p;
+            out[i] = p;
+        }
+        bench::doNotOptimize(out.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch3/chain_apply_fused_aos", 100000, 1000000) {
+    const long n = state.arg();
+    auto links = randomChain();
+    std::vector<Eigen::Vector3d> pts(n, Eigen::Vector3d(0.1, 0.2, 0.3));
+    std::vector<Eigen::Vector3d> out(n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        eigen_tutorial::Affine34<double> T = eigen_tutorial::fuse(links[0], links[1], links[2], links[3]);
+        for (long i = 0; i < n; ++i) out[i] = T * pts[i];
+        bench::doNotOptimize(out.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch3/chain_apply_fused_soa", 100000, 1000000) {
+    const Eigen::Index n = state.arg();
+    auto links = randomChain();
+    eigen_tutorial::TransformChain<double> chain;
+    for (const Eigen::Isometry3d& T : links) chain.push_back(T);
+    eigen_tutorial::PointCloudSoA<double> in(n), out(n);
+    in.x.setRandom();
+    in.y.setRandom();
+    in.z.setRandom();
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        chain.setLink(0, links[0]);  // Force a re-fuse every iteration
+        chain.apply(in, out);
+        bench::doNotOptimize(out.x.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE("ch3/chain_fuse_fixed_k4") {
+    auto links = randomChain();
+    eigen_tutorial::FixedTransformChain<double, kChainLength> chain(links[0], links[1], links[2], links[3]);
+    while (state.keepRunning()) {
+        bench::doNotOptimize(chain);
+        eigen_tutorial::Affine34<double> T = chain.fused();
+        bench::doNotOptimize(T);
+    }
+}
+
+// Rotation vector -> rotation -> rotation vector, as 3.3 does it today
+BENCH_CASE("ch3/so3_exp_log_angle_axis") {
+    auto xi = randomTangents();
+    std::vector<Eigen::Vector3d> out(kTangents);
+    state.setItemsPerIteration(kTangents);
+    while (state.keepRunning()) {
+        for (int i = 0; i < kTangents; ++i) {
+            const Eigen::Vector3d w = xi[i].tail<3>();
+            const double theta = w.norm();
+            const Eigen::Matrix3d R =
+                theta > 0 ? Eigen::AngleAxisd(theta, w / theta).toRotationMatrix() : Eigen::Matrix3d::Identity();
+            const Eigen::AngleAxisd aa(R);
+            out[i] = aa.angle() * aa.axis();
+        }
+        bench::doNotOptimize(out.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE("ch3/so3_exp_log") {
+    auto xi = randomTangents();
+    std::vector<Eigen::Vector3d> out(kTangents);
+    state.setItemsPerIteration(kTangents);
+    while (state.keepRunning()) {
+        for (int i = 0; i < kTangents; ++i) out[i] = eigen_tutorial::SO3d::exp(xi[i].tail<3>()).log();
+        bench::doNotOptimize(out.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE("ch3/so3f_exp_log") {
+    auto xi = randomTangents();
+    std::vector<Eigen::Vector3f> in(kTangents), out(kTangents);
+    for (int i = 0; i < kTangents; ++i) in[i] = xi[i].tail<3>().cast<float>();
+    state.setItemsPerIteration(kTangents);
+    while (state.keepRunning()) {
+        for (int i = 0; i < kTangents; ++i) out[i] = eigen_tutorial::SO3f::exp(in[i]).log();
+        bench::doNotOptimize(out.data());
+        bench::clobberMemory();
+    }
+}
+
+// [t; w] -> Isometry3d -> [t; w]; translation is not the SE(3) rho, but it is
+// the round trip current code does
+BENCH_CASE("ch3/se3_exp_log_isometry") {
+    auto xi = randomTangents();
+    std::vector<eigen_tutorial::SE3d::Tangent> out(kTangents);
+    state.setItemsPerIteration(kTangents);
+    while (state.keepRunning()) {
+        for (int i = 0; i < kTangents; ++i) {
+            const Eigen::Vector3d w = xi[i].tail<3>();
+            const double theta = w.norm();
+            Eigen::Isometry3d T = Eigen::Isometry3d::Identity();
+            if (theta > 0) T.rotate(Eigen::AngleAxisd(theta, w / theta));
+            T.translation() = xi[i].head<3>();
+            const Eigen::AngleAxisd aa(T.rotation());
+            out[i] << T.translation(), aa.angle() * aa.axis();
+        }
+        bench::doNotOptimize(out.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE("ch3/se3_exp_log") {
+    auto xi = randomTangents();
+    std::vector<eigen_tutorial::SE3d::Tangent> out(kTangents);
+    state.setItemsPerIteration(kTangents);
+    while (state.keepRunning()) {
+        for (int i = 0; i < kTangents; ++i) out[i] = eigen_tutorial::SE3d::exp(xi[i]).log();
+        bench::doNotOptimize(out.data());
+        bench::clobberMemory();
+    }
+}
+
+// Relative poses T_i^-1 * T_i+1 along a trajectory
+BENCH_CASE("ch3/se3_relative_isometry") {
+    auto xi = randomTangents();
+    std::vector<Eigen::Isometry3d, Eigen::aligned_allocator<Eigen::Isometry3d>> poses(kTangents), out(kTangents);
+    for (int i = 0; i < kTangents; ++i) poses[i] = eigen_tutorial::SE3d::exp(xi[i]).isometry();
+    state.setItemsPerIteration(kTangents - 1);
+    while (state.keepRunning()) {
+        for (int i = 0; i + 1 < kTangents; ++i) out[i] = poses[i].inverse(Eigen::Isometry) * poses[i + 1];
+        bench::doNotOptimize(out.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE("ch3/se3_relative") {
+    auto xi = randomTangents();
+    std::vector<eigen_tutorial::SE3d, Eigen::aligned_allocator<eigen_tutorial::SE3d>> poses(kTangents), out(kTangents);
+    for (int i = 0; i < kTangents; ++i) poses[i] = eigen_tutorial::SE3d::exp(xi[i]);
+    state.setItemsPerIteration(kTangents - 1);
+    while (state.keepRunning()) {
+        for (int i = 0; i + 1 < kTangents; ++i) out[i] = poses[i].inverse() * poses[i + 1];
+        bench::doNotOptimize(out.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE("ch3/se3_left_jacobian_inverse") {
+    auto xi = randomTangents();
+    std::vector<eigen_tutorial::SE3d::Matrix6, Eigen::aligned_allocator<eigen_tutorial::SE3d::Matrix6>> out(kTangents);
+    state.setItemsPerIteration(kTangents);
+    while (state.keepRunning()) {
+        for (int i = 0; i < kTangents; ++i) out[i] = eigen_tutorial::SE3d::leftJacobianInverse(xi[i]);
+        bench::doNotOptimize(out.data());
+        bench::clobberMemory();
+    }
+}
+
+// Without a cache: compose both chains up to the root on every lookup
+BENCH_CASE("ch3/tf_lookup_chain_walk") {
+    FrameTree frames;
+    state.setItemsPerIteration(kTreeLookups);
+    while (state.keepRunning()) {
+        for (int i = 0; i < kTreeLookups; ++i) {
+            const std::pair<int, int>& q = frames.queries[i % frames.queries.size()];
+            Eigen::Isometry3d T = frames.walk(q.first).inverse() * frames.walk(q.second);
+            bench::doNotOptimize(T);
+        }
+    }
+}
+
+BENCH_CASE("ch3/tf_lookup_cached") {
+    FrameTree frames;
+    state.setItemsPerIteration(kTreeLookups);
+    while (state.keepRunning()) {
+        for (int i = 0; i < kTreeLookups; ++i) {
+            const std::pair<int, int>& q = frames.queries[i % frames.queries.size()];
+            eigen_tutorial::TransformTreed::Transform T = frames.tree.lookup(q.first, q.second);
+            bench::doNotOptimize(T);
+        }
+    }
+}
+
+// Read latency while another thread keeps moving odom and the arm
+BENCH_CASE("ch3/tf_lookup_cached_concurrent_writer") {
+    FrameTree frames;
+    std::atomic<bool> done(false);
+    std::atomic<long> writes(0);
+    std::thread writer([&] {
+        long w = 0;
+        while (!done.load(std::memory_order_relaxed)) {
+            Eigen::Isometry3d T = frames.links[1];
+            T.translation().x() += 1e-6 * w;
+            frames.tree.setLink(1, T);
+            frames.tree.setLink(11 + w % 6, frames.links[11 + w % 6]);
+            w += 2;
+        }
+        writes = w;
+    });
+    int retries = 0;
+    long lookups = 0;
+    state.setItemsPerIteration(kTreeLookups);
+    while (state.keepRunning()) {
+        for (int i = 0; i < kTreeLookups; ++i) {
+            const std::pair<int, int>& q = frames.queries[i % frames.queries.size()];
+            eigen_tutorial::TransformTreed::Transform T = frames.tree.lookup(q.first, q.second, &retries);
+            bench::doNotOptimize(T);
+        }
+        lookups += kTreeLookups;
+    }
+    done = true;
+    writer.join();
+    state.setCounter("retries_per_lookup", lookups ? static_cast<double>(retries) / lookups : 0.0);
+    state.setCounter("writes", static_cast<double>(writes.load()));
+}
+
+BENCH_CASE_ARGS("ch3/rot_matrix_to_quat_eigen", 65536) {
+    const size_t n = state.arg();
+    RotationColumns rot(n);
+    std::vector<Eigen::Quaterniond> out(n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < n; ++i) out[i] = Eigen::Quaterniond(rot.matrices[i]);
+        bench::doNotOptimize(out.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch3/rot_matrix_to_quat_batch", 65536) {
+    const size_t n = state.arg();
+    RotationColumns rot(n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        eigen_tutorial::convertRotations(rot.matrixView(), rot.quaternionView(), n);
+        bench::doNotOptimize(rot.q[0].data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch3/rot_quat_to_matrix_eigen", 65536) {
+    const size_t n = state.arg();
+    RotationColumns rot(n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < n; ++i) rot.matrices[i] = rot.quaternions[i].toRotationMatrix();
+        bench::doNotOptimize(rot.matrices.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch3/rot_quat_to_matrix_batch", 65536) {
+    const size_t n = state.arg();
+    RotationColumns rot(n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        eigen_tutorial::convertRotations(rot.quaternionView(), rot.matrixView(), n);
+        bench::doNotOptimize(rot.m[0].data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch3/rot_quat_to_rotvec_eigen", 65536) {
+    const size_t n = state.arg();
+    RotationColumns rot(n);
+    std::vector<Eigen::Vector3d> out(n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            const Eigen::AngleAxisd aa(rot.quaternions[i]);
+            out[i] = aa.angle() * aa.axis();
+        }
+        bench::doNotOptimize(out.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch3/rot_quat_to_rotvec_batch", 65536) {
+    const size_t n = state.arg();
+    RotationColumns rot(n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        eigen_tutorial::convertRotations(rot.quaternionView(), rot.rotationVectorView(), n);
+        bench::doNotOptimize(rot.v[0].data());
+        bench::clobberMemory();
+    }
+}
@@ -0,0 +1,316 @@
+/**
+ * Benchmarks: Chapter 4 - Solving Linear Systems
+ *
+ * Small fixed-size solves (4.1 / 4.2), one at a time and batched across SIMD
+ * lanes (4.10), overdetermined least squares (4.3), tall ill-conditioned
+ * fits: normal equations vs HouseholderQR vs TSQR (2.17), and the latency
+ * of one new row: Givens update (4.11) vs refactoring, and weighted normal
+ * equations with a dense W vs streamed IRLS passes (4.12), and one LLT
+ * factor against thousands of right-hand sides (4.13)
+ */
+
+#include <vector>
+#include <Eigen/Dense>
+
+#include "bench/bench.h"
+#include "chapter2/tsqr.h"
+#include "chapter4/batched_solve.h"
+#include "chapter4/irls.h"
+#include "chapter4/multi_rhs_solve.h"
+#include "chapter4/recursive_least_squares.h"
+
+namespace {
+
+Eigen::Matrix3d spd3() {
+    Eigen::Matrix3d A = Eigen::Matrix3d::Random();
+    return A * A.transpose() + 3 * Eigen::Matrix3d::Identity();
+}
+
+// m x 12 monomial fit on [0, 1] (condition number ~1e7) with known solution
+void polynomialFit(Eigen::Index m, Eigen::MatrixXd& A, Eigen::VectorXd& b, Eigen::VectorXd& x_true) {
+    const Eigen::Index n = 12;
+    A.resize(m, n);
+    A.col(0).setOnes();
+    A.col(1) = Eigen::VectorXd::LinSpaced(m, 0, 1);
+    for (Eigen::Index j = 2; j < n; ++j) A.col(j) = A.col(j - 1).cwiseProduct(A.col(1));
+    x_true = Eigen::VectorXd::LinSpaced(n, 1, -1);
+    b = A * x_true + 1e-6 * Eigen::VectorXd::Random(m);
+}
+
+// n SPD systems J J^T + damping with random right-hand sides
+template <int N>
+struct SmallSystems {
+    std::vector<Eigen::Matrix<double, N, N>, Eigen::aligned_allocator<Eigen::Matrix<double, N, N>>> A;
+    std::vector<Eigen::Matrix<double, N, 1>, Eigen::aligned_allocator<Eigen::Matrix<double, N, 1>>> b, x;
+
+    explicit SmallSystems(size_t n) : A(n), b(n), x(n) {
+        for (size_t m = 0; m < n; ++m) {
+            const Eigen::Matrix<double, N, 2 * N> J = Eigen::Matrix<double, N, 2 * N>::Random();
+            A[m] = J * J.transpose() + 1e-3 * Eigen::Matrix<double, N, N>::Identity();
+            b[m].setRandom();
+        }
+    }
+};
+
+template <int N>
+void loopLdltCase(bench::State& state) {
+    SmallSystems<N> s(static_cast<size_t>(state.arg()));
+    while (state.keepRunning()) {
+        for (size_t m = 0; m < s.A.size(); ++m) s.x[m] = s.A[m].ldlt().solve(s.b[m]);
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<double>(s.A.size()));
+}
+
+template <int N>
+void batchedSolveCase(bench::State& state, eigen_tutorial::SmallSolver method) {
+    SmallSystems<N> s(static_cast<size_t>(state.arg()));
+    while (state.keepRunning()) {
+        eigen_tutorial::batchedSolve(s.A.data(), s.b.data(), s.A.size(), s.x.data(), method);
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<double>(s.A.size()));
+}
+
+double relativeError(const Eigen::VectorXd& x, const Eigen::VectorXd& x_true) {
+    return (x - x_true).norm() / x_true.norm();
+}
+
+}  // namespace
+
+BENCH_CASE("ch4/solve_3x3_partial_piv_lu") {
+    Eigen::Matrix3d A = spd3();
+    Eigen::Vector3d b = Eigen::Vector3d::Random();
+    while (state.keepRunning()) {
+        bench::doNotOptimize(A);
+        Eigen::Vector3d x = A.partialPivLu().solve(b);
+        bench::doNotOptimize(x);
+    }
+}
+
+BENCH_CASE("ch4/solve_3x3_llt") {
+    Eigen::Matrix3d A = spd3();
+    Eigen::Vector3d b = Eigen::Vector3d::Random();
+    while (state.keepRunning()) {
+        bench::doNotOptimize(A);
+        Eigen::Vector3d x = A.llt().solve(b);
+        bench::doNotOptimize(x);
+    }
+}
+
+BENCH_CASE("ch4/solve_3x3_ldlt") {
+    Eigen::Matrix3d A = spd3();
+    Eigen::Vector3d b = Eigen::Vector3d::Random();
+    while (state.keepRunning()) {
+        bench::doNotOptimize(A);
+        Eigen::Vector3d x = A.ldlt().solve(b);
+        bench::doNotOptimize(x);
+    }
+}
+
+BENCH_CASE("ch4/solve_6x6_ldlt") {
+    Eigen::Matrix<double, 6, 6> M = Eigen::Matrix<double, 6, 6>::Random();
+    Eigen::Matrix<double, 6, 6> A = M * M.transpose() + 6 * Eigen::Matrix<double, 6, 6>::Identity();
+    Eigen::Matrix<double, 6, 1> b = Eigen::Matrix<double, 6, 1>::Random();
+    while (state.keepRunning()) {
+        bench::doNotOptimize(A);
+        Eigen::Matrix<double, 6, 1> x = A.ldlt().solve(b);
+        bench::doNotOptimize(x);
+    }
+}
+
+// 4.10: many independent systems, a loop of ldlt() vs one lane per system
+BENCH_CASE_ARGS("ch4/loop_ldlt_3x3", 65536) {
+    loopLdltCase<3>(state);
+}
+
+BENCH_CASE_ARGS("ch4/batched_cholesky_3x3", 65536) {
+    batchedSolveCase<3>(state, eigen_tutorial::SmallSolver::kCholesky);
+}
+
+BENCH_CASE_ARGS("ch4/batched_ldlt_3x3", 65536) {
+    batchedSolveCase<3>(state, eigen_tutorial::SmallSolver::kLdlt);
+}
+
+BENCH_CASE_ARGS("ch4/batched_lu_3x3", 65536) {
+    batchedSolveCase<3>(state, eigen_tutorial::SmallSolver::kLu);
+}
+
+BENCH_CASE_ARGS("ch4/loop_ldlt_6x6", 16384) {
+    loopLdltCase<6>(state);
+}
+
+BENCH_CASE_ARGS("ch4/batched_ldlt_6x6", 16384) {
+    batchedSolveCase<6>(state, eigen_tutorial::SmallSolver::kLdlt);
+}
+
+// 4.3: line fitting y = a + b*x with many rows, three ways
+BENCH_CASE_ARGS("ch4/lsq_normal_equations", 1000, 100000) {
+    const long m = state.arg();
+    Eigen::MatrixXd A(m, 2);
+    A.col(0).setOnes();
+    A.col(1) = Eigen::VectorXd::LinSpaced(m, 0, 10);
+    Eigen::VectorXd b = 2.0 * A.col(1) + Eigen::VectorXd::Random(m);
+    while (state.keepRunning()) {
+        Eigen::Vector2d x = (A.transpose() * A).ldlt().solve(A.transpose() * b);
+        bench::doNotOptimize(x);
+    }
+}
+
+BENCH_CASE_ARGS("ch4/lsq_householder_qr", 1000, 100000) {
+    const long m = state.arg();
+    Eigen::MatrixXd A(m, 2);
+    A.col(0).setOnes();
+    A.col(1) = Eigen::VectorXd::LinSpaced(m, 0, 10);
+    Eigen::VectorXd b = 2.0 * A.col(1) + Eigen::VectorXd::Random(m);
+    while (state.keepRunning()) {
+        Eigen::VectorXd x = A.householderQr().solve(b);
+        bench::doNotOptimize(x.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch4/lsq_bdc_svd", 1000, 100000) {
+    const long m = state.arg();
+    Eigen::MatrixXd A(m, 2);
+    A.col(0).setOnes();
+    A.col(1) = Eigen::VectorXd::LinSpaced(m, 0, 10);
+    Eigen::VectorXd b = 2.0 * A.col(1) + Eigen::VectorXd::Random(m);
+    while (state.keepRunning()) {
+        Eigen::VectorXd x = A.bdcSvd(Eigen::ComputeThinU | Eigen::ComputeThinV).solve(b);
+        bench::doNotOptimize(x.data());
+        bench::clobberMemory();
+    }
+}
+
+// Tall, ill-conditioned fits: the normal equations square cond(A), TSQR
+// keeps QR's accuracy and factors row chunks on all threads
+BENCH_CASE_ARGS("ch4/tall_normal_equations", 100000, 1000000) {
+    Eigen::MatrixXd A;
+    Eigen::VectorXd b, x_true, x;
+    polynomialFit(state.arg(), A, b, x_true);
+    while (state.keepRunning()) {
+        x = (A.transpose() * A).ldlt().solve(A.transpose() * b);
+        bench::doNotOptimize(x.data());
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(state.arg());
+    state.setCounter("rel_err", relativeError(x, x_true));
+}
+
+BENCH_CASE_ARGS("ch4/tall_householder_qr", 100000, 1000000) {
+    Eigen::MatrixXd A;
+    Eigen::VectorXd b, x_true, x;
+    polynomialFit(state.arg(), A, b, x_true);
+    while (state.keepRunning()) {
+        x = A.householderQr().solve(b);
+        bench::doNotOptimize(x.data());
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(state.arg());
+    state.setCounter("rel_err", relativeError(x, x_true));
+}
+
+BENCH_CASE_ARGS("ch4/tall_tsqr", 100000, 1000000) {
+    Eigen::MatrixXd A;
+    Eigen::VectorXd b, x_true, x;
+    polynomialFit(state.arg(), A, b, x_true);
+    while (state.keepRunning()) {
+        x = eigen_tutorial::tsqrLeastSquares(A, b);
+        bench::doNotOptimize(x.data());
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(state.arg());
+    state.setCounter("rel_err", relativeError(x, x_true));
+}
+
+// 4.11: one new row of a 6-parameter fit, then the updated solution
+BENCH_CASE_ARGS("ch4/rls_givens_update", 6, 20) {
+    const Eigen::Index n = state.arg();
+    const Eigen::MatrixXd A = Eigen::MatrixXd::Random(1024, n);
+    const Eigen::VectorXd b = Eigen::VectorXd::Random(1024);
+    eigen_tutorial::RecursiveLeastSquares rls(n);
+    rls.addRows(A, b);
+    Eigen::VectorXd x(n);
+    Eigen::Index i = 0;
+    while (state.keepRunning()) {
+        rls.addRow(A.row(i), b(i));
+        rls.solve(x);
+        bench::doNotOptimize(x.data());
+        i = (i + 1) % A.rows();
+    }
+}
+
+// The same update by refactoring all m rows seen so far
+BENCH_CASE_ARGS("ch4/rls_refactor_qr", 100, 1000, 10000) {
+    const Eigen::MatrixXd A = Eigen::MatrixXd::Random(state.arg(), 6);
+    const Eigen::VectorXd b = Eigen::VectorXd::Random(state.arg());
+    Eigen::VectorXd x(6);
+    while (state.keepRunning()) {
+        x = A.householderQr().solve(b);
+        bench::doNotOptimize(x.data());
+    }
+}
+
+// 4.12: A^T W A and A^T W b for an m x 4 fit with per-row weights, through
+// a dense m x m W
+BENCH_CASE_ARGS("ch4/irls_dense_w", 1000, 4000) {
+    const Eigen::MatrixXd A = Eigen::MatrixXd::Random(state.arg(), 4);
+    const Eigen::VectorXd b = Eigen::VectorXd::Random(state.arg());
+    const Eigen::VectorXd weights = Eigen::VectorXd::Random(state.arg()).cwiseAbs();
+    Eigen::MatrixXd H;
+    Eigen::VectorXd g;
+    while (state.keepRunning()) {
+        const Eigen::MatrixXd W = weights.asDiagonal();
+        H = A.transpose() * W * A;
+        g = A.transpose() * W * b;
+        bench::doNotOptimize(H.data());
+        bench::doNotOptimize(g.data());
+    }
+    state.setItemsPerIteration(state.arg());
+}
+
+// The same, streamed, and one Huber-reweighted pass at 1M rows
+BENCH_CASE_ARGS("ch4/irls_streamed_pass", 1000, 4000, 1 << 20) {
+    const Eigen::MatrixXd A = Eigen::MatrixXd::Random(state.arg(), 4);
+    const Eigen::VectorXd b = Eigen::VectorXd::Random(state.arg());
+    const Eigen::VectorXd weights = Eigen::VectorXd::Random(state.arg()).cwiseAbs();
+    eigen_tutorial::IrlsProblem problem(A, b);
+    problem.setRowWeights(weights);
+    const Eigen::VectorXd x = Eigen::VectorXd::Zero(4);
+    Eigen::MatrixXd H;
+    Eigen::VectorXd g;
+    while (state.keepRunning()) {
+        problem.normalEquations(x, eigen_tutorial::RobustKernel::kHuber, 0.5, H, g);
+        bench::doNotOptimize(H.data());
+        bench::doNotOptimize(g.data());
+    }
+    state.setItemsPerIteration(state.arg());
+}
+
+// 4.13: 2000 right-hand sides against one n x n LLT factor
+BENCH_CASE_ARGS("ch4/multi_rhs_llt_eigen", 500) {
+    const Eigen::MatrixXd J = Eigen::MatrixXd::Random(2 * state.arg(), state.arg());
+    const Eigen::LLT<Eigen::MatrixXd> llt(J.transpose() * J);
+    const Eigen::MatrixXd B = Eigen::MatrixXd::Random(state.arg(), 2000);
+    Eigen::MatrixXd X;
+    while (state.keepRunning()) {
+        X = llt.solve(B);
+        bench::doNotOptimize(X.data());
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<double>(B.cols()));
+}
+
+BENCH_CASE_ARGS("ch4/multi_rhs_llt_blocked", 500) {
+    const Eigen::MatrixXd J = Eigen::MatrixXd::Random(2 * state.arg(), state.arg());
+    const Eigen::LLT<Eigen::MatrixXd> llt(J.transpose() * J);
+    const Eigen::MatrixXd B = Eigen::MatrixXd::Random(state.arg(), 2000);
+    Eigen::MatrixXd X;
+    while (state.keepRunning()) {
+        eigen_tutorial::solveMultiRhs(llt, B, X);
+        bench::doNotOptimize(X.data());
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<double>(B.cols()));
+}
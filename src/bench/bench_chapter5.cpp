@@ -0,0 +1,140 @@
+/**
+ * Benchmarks: Chapter 5 - Sparse Matrices
+ *
+ * Assembly from triplets and direct / iterative solves on a pose-graph
+ * shaped Hessian (5.7): 3x3 blocks on a chain plus a few loop closures,
+ * and one factor against 256 right-hand sides: column by column inside
+ * Eigen vs row-major column blocks (4.13)
+ */
+
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+#include <Eigen/IterativeLinearSolvers>
+
+#include "bench/bench.h"
+#include "chapter4/multi_rhs_solve.h"
+
+namespace {
+
+typedef Eigen::Triplet<double> T;
+
+std::vector<T> poseGraphTriplets(int num_poses) {
+    const int d = 3;
+    std::vector<T> trips;
+    trips.reserve(static_cast<size_t>(num_poses) * d * d * 5);
+    auto addEdge = [&](int i, int j) {
+        for (int r = 0; r < d; ++r) {
+            for (int c = 0; c < d; ++c) {
+                double val = (r == c) ? 1.0 : 0.05;
+                trips.push_back(T(i * d + r, i * d + c, val));
+                trips.push_back(T(j * d + r, j * d + c, val));
+                trips.push_back(T(i * d + r, j * d + c, -val));
+                trips.push_back(T(j * d + r, i * d + c, -val));
+            }
+        }
+    };
+    for (int i = 0; i < d; ++i) trips.push_back(T(i, i, 1.0));  // Prior on pose 0
+    for (int i = 0; i + 1 < num_poses; ++i) addEdge(i, i + 1);  // Odometry
+    for (int i = 0; i + 50 < num_poses; i += 50) addEdge(i, i + 50);  // Loop closures
+    return trips;
+}
+
+Eigen::SparseMatrix<double> poseGraphHessian(int num_poses) {
+    std::vector<T> trips = poseGraphTriplets(num_poses);
+    Eigen::SparseMatrix<double> H(3 * num_poses, 3 * num_poses);
+    H.setFromTriplets(trips.begin(), trips.end());
+    return H;
+}
+
+}  // namespace
+
+BENCH_CASE_ARGS("ch5/assemble_from_triplets", 1000, 10000) {
+    const int n = static_cast<int>(state.arg());
+    std::vector<T> trips = poseGraphTriplets(n);
+    state.setItemsPerIteration(static_cast<double>(trips.size()));
+    while (state.keepRunning()) {
+        Eigen::SparseMatrix<double> H(3 * n, 3 * n);
+        H.setFromTriplets(trips.begin(), trips.end());
+        bench::doNotOptimize(H.valuePtr());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch5/simplicial_ldlt_compute", 1000, 10000) {
+    Eigen::SparseMatrix<double> H = poseGraphHessian(static_cast<int>(state.arg()));
+    Eigen::VectorXd b = Eigen::VectorXd::Ones(H.rows());
+    while (state.keepRunning()) {
+        Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver(H);
+        Eigen::VectorXd x = solver.solve(b);
+        bench::doNotOptimize(x.data());
+        bench::clobberMemory();
+    }
+}
+
+// 5.9: analyzePattern() once, factorize() per solve
+BENCH_CASE_ARGS("ch5/simplicial_ldlt_refactorize", 1000, 10000) {
+    Eigen::SparseMatrix<double> H = poseGraphHessian(static_cast<int>(state.arg()));
+    Eigen::VectorXd b = Eigen::VectorXd::Ones(H.rows());
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver;
+    solver.analyzePattern(H);
+    while (state.keepRunning()) {
+        solver.factorize(H);
+        Eigen::VectorXd x = solver.solve(b);
+        bench::doNotOptimize(x.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch5/conjugate_gradient", 1000, 10000) {
+    Eigen::SparseMatrix<double> H = poseGraphHessian(static_cast<int>(state.arg()));
+    Eigen::VectorXd b = Eigen::VectorXd::Ones(H.rows());
+    Eigen::ConjugateGradient<Eigen::SparseMatrix<double>, Eigen::Lower | Eigen::Upper> cg;
+    cg.setTolerance(1e-8);
+    cg.compute(H);
+    while (state.keepRunning()) {
+        Eigen::VectorXd x = cg.solve(b);
+        bench::doNotOptimize(x.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch5/sparse_matvec", 1000, 10000) {
+    Eigen::SparseMatrix<double> H = poseGraphHessian(static_cast<int>(state.arg()));
+    Eigen::VectorXd x = Eigen::VectorXd::Random(H.cols());
+    Eigen::VectorXd y(H.rows());
+    state.setItemsPerIteration(static_cast<double>(H.nonZeros()));
+    while (state.keepRunning()) {
+        y.noalias() = H * x;
+        bench::doNotOptimize(y.data());
+        bench::clobberMemory();
+    }
+}
+
+// 4.13: columns of H^-1 for 256 unknowns from one factor
+BENCH_CASE_ARGS("ch5/multi_rhs_ldlt_eigen", 1000, 10000) {
+    Eigen::SparseMatrix<double> H = poseGraphHessian(static_cast<int>(state.arg()));
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver(H);
+    const Eigen::MatrixXd B = Eigen::MatrixXd::Identity(H.rows(), H.rows()).rightCols(256);
+    Eigen::MatrixXd X;
+    state.setItemsPerIteration(static_cast<double>(B.cols()));
+    while (state.keepRunning()) {
+        X = solver.solve(B);
+        bench::doNotOptimize(X.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch5/multi_rhs_ldlt_blocked", 1000, 10000) {
+    Eigen::SparseMatrix<double> H = poseGraphHessian(static_cast<int>(state.arg()));
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver(H);
+    const Eigen::MatrixXd B = Eigen::MatrixXd::Identity(H.rows(), H.rows()).rightCols(256);
+    Eigen::MatrixXd X;
+    state.setItemsPerIteration(static_cast<double>(B.cols()));
+    while (state.keepRunning()) {
+        eigen_tutorial::solveMultiRhs(solver, B, X);
+        bench::doNotOptimize(X.data());
+        bench::clobberMemory();
+    }
+}
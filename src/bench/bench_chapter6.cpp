@@ -0,0 +1,199 @@
+/**
+ * Benchmarks: Chapter 6 - Optimization Basics
+ *
+ * Full Gauss-Newton (6.4) and Levenberg-Marquardt (6.5) solves of the
+ * y = a*exp(b*x) curve fit, with more data points than the tutorials use;
+ * frustum culling of a landmark map against a loop of keyframes (6.10)
+ */
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "bench/bench.h"
+#include "chapter6/frustum_culling.h"
+
+namespace {
+
+struct CurveData {
+    std::vector<double> x, y;
+};
+
+CurveData makeCurve(int n) {
+    CurveData d;
+    std::mt19937 rng(42);
+    std::normal_distribution<double> noise(0.0, 0.05);
+    for (int i = 0; i < n; ++i) {
+        double xi = 3.0 * i / (n - 1);
+        d.x.push_back(xi);
+        d.y.push_back(2.0 * std::exp(0.5 * xi) + noise(rng));
+    }
+    return d;
+}
+
+double cost(const CurveData& d, double a, double b) {
+    double c = 0;
+    for (size_t i = 0; i < d.x.size(); ++i) {
+        double r = d.y[i] - a * std::exp(b * d.x[i]);
+        c += r * r;
+    }
+    return c;
+}
+
+// Accumulates J^T J and -J^T r directly instead of forming the n x 2 Jacobian
+void linearize(const CurveData& d, double a, double b, Eigen::Matrix2d& H, Eigen::Vector2d& g) {
+    H.setZero();
+    g.setZero();
+    for (size_t i = 0; i < d.x.size(); ++i) {
+        double e = std::exp(b * d.x[i]);
+        double r = d.y[i] - a * e;
+        Eigen::Vector2d J(-e, -a * d.x[i] * e);
+        H += J * J.transpose();
+        g -= J * r;
+    }
+}
+
+// Landmarks over a 1 km square, 16 keyframes on a loop looking forward
+struct LandmarkMap {
+    std::vector<Eigen::Vector3d> points;
+    eigen_tutorial::PointCloudSoA<double> cloud;
+    std::vector<Eigen::Isometry3d, Eigen::aligned_allocator<Eigen::Isometry3d>> poses;
+    eigen_tutorial::PinholeCamera camera{500, 500, 320, 240, 640, 480, 0.5, 60};
+};
+
+LandmarkMap makeMap(size_t n) {
+    LandmarkMap map;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> ground(0, 1000), height(0, 20);
+    map.cloud.resize(static_cast<Eigen::Index>(n));
+    for (size_t i = 0; i < n; ++i) {
+        map.points.emplace_back(ground(rng), ground(rng), height(rng));
+        map.cloud.setPoint(static_cast<Eigen::Index>(i), map.points.back());
+    }
+    for (int k = 0; k < 16; ++k) {
+        const double a = 2 * M_PI * k / 16;
+        Eigen::Matrix3d R;
+        R.col(2) = Eigen::Vector3d(-std::sin(a), std::cos(a), 0);
+        R.col(1) = -Eigen::Vector3d::UnitZ();
+        R.col(0) = R.col(1).cross(R.col(2));
+        Eigen::Isometry3d T_world_camera = Eigen::Isometry3d::Identity();
+        T_world_camera.linear() = R;
+        T_world_camera.translation() = Eigen::Vector3d(500 + 400 * std::cos(a), 500 + 400 * std::sin(a), 1.5);
+        map.poses.push_back(T_world_camera.inverse());
+    }
+    return map;
+}
+
+void frustumCullCase(bench::State& state, double cell_size) {
+    const LandmarkMap map = makeMap(static_cast<size_t>(state.arg()));
+    eigen_tutorial::FrustumCullerd culler;
+    culler.setLandmarks(map.cloud, cell_size);
+    std::vector<eigen_tutorial::FrustumCullerd::Bitset> bits;
+    while (state.keepRunning()) {
+        culler.visibleBatch(map.poses, map.camera, bits);
+        bench::clobberMemory();
+    }
+    state.setItemsPerIteration(static_cast<double>(map.points.size() * map.poses.size()));
+}
+
+}  // namespace
+
+BENCH_CASE_ARGS("ch6/gauss_newton_curve_fit", 100, 10000) {
+    CurveData d = makeCurve(static_cast<int>(state.arg()));
+    while (state.keepRunning()) {
+        double a = 1.0, b = 1.0;
+        for (int iter = 0; iter < 20; ++iter) {
+            Eigen::Matrix2d H;
+            Eigen::Vector2d g;
+            linearize(d, a, b, H, g);
+            Eigen::Vector2d dx = H.ldlt().solve(g);
+            a += dx(0);
+            b += dx(1);
+            if (dx.norm() < 1e-10) break;
+        }
+        bench::doNotOptimize(a);
+        bench::doNotOptimize(b);
+    }
+}
+
+// Same as 6.4, with the dense n x 2 Jacobian the tutorial builds
+BENCH_CASE_ARGS("ch6/gauss_newton_dense_jacobian", 100, 10000) {
+    CurveData d = makeCurve(static_cast<int>(state.arg()));
+    const int n = static_cast<int>(d.x.size());
+    Eigen::VectorXd r(n);
+    Eigen::MatrixXd J(n, 2);
+    while (state.keepRunning()) {
+        double a = 1.0, b = 1.0;
+        for (int iter = 0; iter < 20; ++iter) {
+            for (int i = 0; i < n; ++i) {
+                double e = std::exp(b * d.x[i]);
+                r(i) = d.y[i] - a * e;
+                J(i, 0) = -e;
+                J(i, 1) = -a * d.x[i] * e;
+            }
+            Eigen::Vector2d dx = (J.transpose() * J).ldlt().solve(-J.transpose() * r);
+            a += dx(0);
+            b += dx(1);
+            if (dx.norm() < 1e-10) break;
+        }
+        bench::doNotOptimize(a);
+        bench::doNotOptimize(b);
+    }
+}
+
+BENCH_CASE_ARGS("ch6/levenberg_marquardt_curve_fit", 100, 10000) {
+    CurveData d = makeCurve(static_cast<int>(state.arg()));
+    while (state.keepRunning()) {
+        double a = 1.0, b = 1.0, lambda = 0.01;
+        double c = cost(d, a, b);
+        for (int iter = 0; iter < 50; ++iter) {
+            Eigen::Matrix2d H;
+            Eigen::Vector2d g;
+            linearize(d, a, b, H, g);
+            Eigen::Vector2d dx = (H + lambda * Eigen::Matrix2d::Identity()).ldlt().solve(g);
+            double c_new = cost(d, a + dx(0), b + dx(1));
+            if (c_new < c) {
+                a += dx(0);
+                b += dx(1);
+                lambda /= 2;
+                if (std::abs(c - c_new) < 1e-12) break;
+                c = c_new;
+            } else {
+                lambda *= 2;
+            }
+        }
+        bench::doNotOptimize(a);
+        bench::doNotOptimize(b);
+    }
+}
+
+// Per landmark and keyframe: T * p, then the projection of 6.7
+BENCH_CASE_ARGS("ch6/frustum_cull_reference", 1 << 18) {
+    const LandmarkMap map = makeMap(static_cast<size_t>(state.arg()));
+    const eigen_tutorial::PinholeCamera& cam = map.camera;
+    while (state.keepRunning()) {
+        size_t visible = 0;
+        for (const Eigen::Isometry3d& T : map.poses) {
+            for (const Eigen::Vector3d& landmark : map.points) {
+                const Eigen::Vector3d p = T * landmark;
+                if (p.z() < cam.min_depth || p.z() > cam.max_depth) continue;
+                const double u = cam.fx * p.x() / p.z() + cam.cx, v = cam.fy * p.y() / p.z() + cam.cy;
+                visible += u >= 0 && u < cam.width && v >= 0 && v < cam.height;
+            }
+        }
+        bench::doNotOptimize(visible);
+    }
+    state.setItemsPerIteration(static_cast<double>(map.points.size() * map.poses.size()));
+}
+
+// Every keyframe tests every landmark, SoA + bitsets
+BENCH_CASE_ARGS("ch6/frustum_cull_soa", 1 << 18) {
+    frustumCullCase(state, 0);
+}
+
+// Coarse 25 m grid skips the cells outside each frustum
+BENCH_CASE_ARGS("ch6/frustum_cull_grid", 1 << 18) {
+    frustumCullCase(state, 25);
+}
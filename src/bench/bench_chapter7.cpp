@@ -0,0 +1,211 @@
+/**
+ * Benchmarks: Chapter 7 - Advanced Topics
+ *
+ * Trajectory storage (7.10): Isometry3d <-> quaternion + translation SoA,
+ * and whole-trajectory reads from the memory-mapped file
+ *
+ * Pose interpolation (7.11): per-query binary search + Quaterniond::slerp vs
+ * PoseBuffer's batched lookup into SoA columns, sorted and shuffled times
+ */
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "bench/bench.h"
+#include "chapter7/mapped_trajectory.h"
+#include "chapter7/pose_buffer.h"
+
+namespace {
+
+typedef std::vector<Eigen::Isometry3d, Eigen::aligned_allocator<Eigen::Isometry3d>> IsometryVector;
+
+IsometryVector randomPoses(size_t n) {
+    IsometryVector poses(n);
+    for (Eigen::Isometry3d& T : poses) {
+        T.setIdentity();
+        T.rotate(Eigen::Quaterniond::UnitRandom());
+        T.translation() = 100 * Eigen::Vector3d::Random();
+    }
+    return poses;
+}
+
+// In-memory SoA columns for the conversion kernels
+struct ColumnBuffers {
+    std::vector<double> q[4], t[3];
+    explicit ColumnBuffers(size_t n) {
+        for (auto& c : q) c.resize(n);
+        for (auto& c : t) c.resize(n);
+    }
+    eigen_tutorial::TrajectoryColumns<double> columns() {
+        return eigen_tutorial::TrajectoryColumns<double>{q[0].data(), q[1].data(), q[2].data(), q[3].data(),
+                                                         t[0].data(), t[1].data(), t[2].data(), nullptr};
+    }
+};
+
+// Mapped file holding n poses, removed when the bench case ends
+struct TempTrajectory {
+    std::string path;
+    eigen_tutorial::MappedTrajectoryd log;
+    explicit TempTrajectory(const IsometryVector& poses) {
+        char name[] = "/tmp/eigen_bench_trajectoryXXXXXX";
+        const int fd = mkstemp(name);
+        if (fd >= 0) ::close(fd);
+        path = name;
+        if (log.create(path, false)) log.append(poses.data(), poses.size());
+    }
+    ~TempTrajectory() {
+        log.close();
+        ::unlink(path.c_str());
+    }
+};
+
+// 200 Hz odometry over 60 s, turning fast enough that some segments need
+// SLERP, and n query times over it
+struct InterpolationProblem {
+    std::vector<double> stamps, times;
+    std::vector<Eigen::Quaterniond> q;
+    std::vector<Eigen::Vector3d> p;
+    eigen_tutorial::PoseBufferd buffer;
+
+    InterpolationProblem(size_t n, bool sorted) : times(n) {
+        Eigen::Quaterniond qk = Eigen::Quaterniond::Identity();
+        for (int i = 0; i <= 12000; ++i) {
+            const double t = i * (1.0 / 200);
+            stamps.push_back(t);
+            q.push_back(qk);
+            p.push_back(Eigen::Vector3d(10 * t, std::sin(t), 0));
+            buffer.push(t, qk, p.back());
+            qk = (qk * Eigen::Quaterniond(Eigen::AngleAxisd(0.03 * std::sin(0.5 * t), Eigen::Vector3d::UnitZ())))
+                     .normalized();
+        }
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<double> uniform(0, stamps.back());
+        for (double& t : times) t = uniform(rng);
+        if (sorted) std::sort(times.begin(), times.end());
+    }
+};
+
+void eigenSlerpCase(bench::State& state, bool sorted) {
+    const size_t n = state.arg();
+    InterpolationProblem problem(n, sorted);
+    std::vector<Eigen::Quaterniond> q_out(n);
+    std::vector<Eigen::Vector3d> p_out(n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        for (size_t k = 0; k < n; ++k) {
+            const double t = problem.times[k];
+            const size_t j = std::upper_bound(problem.stamps.begin(), problem.stamps.end() - 1, t) -
+                             problem.stamps.begin();
+            const size_t i = j - 1;
+            const double u = (t - problem.stamps[i]) / (problem.stamps[j] - problem.stamps[i]);
+            q_out[k] = problem.q[i].slerp(u, problem.q[j]);
+            p_out[k] = (1 - u) * problem.p[i] + u * problem.p[j];
+        }
+        bench::doNotOptimize(q_out.data());
+        bench::clobberMemory();
+    }
+}
+
+void poseBufferCase(bench::State& state, bool sorted) {
+    const size_t n = state.arg();
+    InterpolationProblem problem(n, sorted);
+    ColumnBuffers out(n);
+    const eigen_tutorial::TrajectoryColumns<double> columns = out.columns();
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        problem.buffer.interpolate(problem.times.data(), n, columns);
+        bench::doNotOptimize(out.q[0].data());
+        bench::clobberMemory();
+    }
+}
+
+}  // namespace
+
+BENCH_CASE_ARGS("ch7/trajectory_append_columns", 256, 65536) {
+    const size_t n = state.arg();
+    IsometryVector poses = randomPoses(n);
+    ColumnBuffers out(n);
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            const Eigen::Quaterniond q(poses[i].linear());
+            out.q[0][i] = q.w();
+            out.q[1][i] = q.x();
+            out.q[2][i] = q.y();
+            out.q[3][i] = q.z();
+            out.t[0][i] = poses[i].translation().x();
+            out.t[1][i] = poses[i].translation().y();
+            out.t[2][i] = poses[i].translation().z();
+        }
+        bench::doNotOptimize(out.q[0].data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch7/soa_to_isometry_eigen", 256, 65536) {
+    const size_t n = state.arg();
+    IsometryVector poses = randomPoses(n);
+    ColumnBuffers in(n);
+    eigen_tutorial::detail::isometriesToColumns(poses.data(), n, in.columns());
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            const Eigen::Quaterniond q(in.q[0][i], in.q[1][i], in.q[2][i], in.q[3][i]);
+            poses[i].linear() = q.normalized().toRotationMatrix();
+            poses[i].translation() = Eigen::Vector3d(in.t[0][i], in.t[1][i], in.t[2][i]);
+        }
+        bench::doNotOptimize(poses.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch7/soa_to_isometry_straight_line", 256, 65536) {
+    const size_t n = state.arg();
+    IsometryVector poses = randomPoses(n);
+    ColumnBuffers in(n);
+    const eigen_tutorial::TrajectoryColumns<double> columns = in.columns();
+    eigen_tutorial::detail::isometriesToColumns(poses.data(), n, columns);
+    state.setItemsPerIteration(static_cast<double>(n));
+    while (state.keepRunning()) {
+        eigen_tutorial::detail::columnsToIsometries(columns, n, poses.data());
+        bench::doNotOptimize(poses.data());
+        bench::clobberMemory();
+    }
+}
+
+// Whole-trajectory read from the mapped file (bandwidth bound)
+BENCH_CASE_ARGS("ch7/mapped_trajectory_read", 1000000) {
+    const size_t n = state.arg();
+    IsometryVector poses = randomPoses(n);
+    TempTrajectory file(poses);
+    state.setItemsPerIteration(static_cast<double>(n));
+    state.setBytesPerIteration(static_cast<double>(n * (7 * sizeof(double) + sizeof(Eigen::Isometry3d))));
+    while (state.keepRunning()) {
+        file.log.read(0, n, poses.data());
+        bench::doNotOptimize(poses.data());
+        bench::clobberMemory();
+    }
+}
+
+BENCH_CASE_ARGS("ch7/pose_interp_eigen_slerp_sorted", 100000) {
+    eigenSlerpCase(state, true);
+}
+
+BENCH_CASE_ARGS("ch7/pose_interp_batch_sorted", 100000) {
+    poseBufferCase(state, true);
+}
+
+BENCH_CASE_ARGS("ch7/pose_interp_eigen_slerp_shuffled", 100000) {
+    eigenSlerpCase(state, false);
+}
+
+BENCH_CASE_ARGS("ch7/pose_interp_batch_shuffled", 100000) {
+    poseBufferCase(state, false);
+}
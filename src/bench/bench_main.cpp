@@ -0,0 +1,266 @@
+/**
+ * Benchmark driver
+ *
+ * Runs every case registered with BENCH_CASE / BENCH_CASE_ARGS, prints a
+ * statistics table and optionally writes JSON / compares against a baseline.
+ *
+ *   ./bench                                   # run everything
+ *   ./bench --filter=ch2/                     # substring filter on case names
+ *   ./bench --json=run.json                   # machine-readable results
+ *   ./bench --baseline=old.json --threshold=0.10
+ *                                             # flag median slowdowns > 10%
+ *   ./bench --list
+ *
+ * Exit code is 1 when --baseline finds a regression, so CI can gate on it.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <Eigen/Core>
+
+#include "bench/bench.h"
+
+namespace {
+
+struct Result {
+    std::string name;
+    long batch;
+    size_t n_samples;
+    bench::Stats stats;
+    double items_per_iter;
+    double bytes_per_iter;
+    std::vector<std::pair<std::string, double>> counters;
+};
+
+std::string formatTime(double ns) {
+    char buf[32];
+    if (ns < 1e3) {
+        std::snprintf(buf, sizeof(buf), "%.1f ns", ns);
+    } else if (ns < 1e6) {
+        std::snprintf(buf, sizeof(buf), "%.2f us", ns / 1e3);
+    } else if (ns < 1e9) {
+        std::snprintf(buf, sizeof(buf), "%.2f ms", ns / 1e6);
+    } else {
+        std::snprintf(buf, sizeof(buf), "%.2f s", ns / 1e9);
+    }
+    return buf;
+}
+
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+std::string simdName() {
+    return Eigen::SimdInstructionSetsInUse();
+}
+
+// One benchmark object per line, so the baseline reader below can stay trivial
+void writeJson(const std::string& path, const std::vector<Result>& results,
+               const bench::Config& cfg) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Cannot open " << path << " for writing\n";
+        return;
+    }
+    std::time_t now = std::time(nullptr);
+    char date[64];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    out << "{\n";
+    out << "  \"context\": {\"date\": \"" << date << "\""
+        << ", \"eigen_version\": \"" << EIGEN_WORLD_VERSION << "." << EIGEN_MAJOR_VERSION
+        << "." << EIGEN_MINOR_VERSION << "\""
+#if defined(__VERSION__)
+        << ", \"compiler\": \"" << jsonEscape(__VERSION__) << "\""
+#endif
+        << ", \"simd\": \"" << jsonEscape(simdName()) << "\""
+        << ", \"hardware_threads\": " << std::thread::hardware_concurrency()
+        << ", \"repetitions\": " << cfg.repetitions
+        << ", \"warmup_ms\": " << cfg.warmup_ms
+        << ", \"min_sample_ms\": " << cfg.min_sample_ms << "},\n";
+    out << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        const bench::Stats& s = r.stats;
+        out.precision(6);
+        out << std::fixed;
+        out << "    {\"name\": \"" << jsonEscape(r.name) << "\""
+            << ", \"batch\": " << r.batch
+            << ", \"samples\": " << r.n_samples
+            << ", \"min_ns\": " << s.min_ns
+            << ", \"median_ns\": " << s.median_ns
+            << ", \"mean_ns\": " << s.mean_ns
+            << ", \"stddev_ns\": " << s.stddev_ns
+            << ", \"p90_ns\": " << s.p90_ns
+            << ", \"p99_ns\": " << s.p99_ns
+            << ", \"max_ns\": " << s.max_ns;
+        if (r.items_per_iter > 0) {
+            out << ", \"items_per_second\": " << r.items_per_iter * 1e9 / s.median_ns;
+        }
+        if (r.bytes_per_iter > 0) {
+            out << ", \"bytes_per_second\": " << r.bytes_per_iter * 1e9 / s.median_ns;
+        }
+        for (const auto& c : r.counters) {
+            out << ", \"" << jsonEscape(c.first) << "\": " << std::scientific << c.second << std::fixed;
+        }
+        out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    std::cout << "\nWrote " << results.size() << " results to " << path << "\n";
+}
+
+// Reads {"name": ..., "median_ns": ...} pairs from a file written by writeJson()
+std::map<std::string, double> readBaseline(const std::string& path) {
+    std::map<std::string, double> medians;
+    std::ifstream in(path);
+    std::string line;
+    const std::string name_key = "\"name\": \"";
+    const std::string median_key = "\"median_ns\": ";
+    while (std::getline(in, line)) {
+        size_t n = line.find(name_key);
+        size_t m = line.find(median_key);
+        if (n == std::string::npos || m == std::string::npos) continue;
+        n += name_key.size();
+        size_t end = line.find('"', n);
+        medians[line.substr(n, end - n)] = std::atof(line.c_str() + m + median_key.size());
+    }
+    return medians;
+}
+
+bool parseOption(const char* arg, const char* key, std::string& value) {
+    size_t len = std::strlen(key);
+    if (std::strncmp(arg, key, len) == 0 && arg[len] == '=') {
+        value = arg + len + 1;
+        return true;
+    }
+    return false;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bench::Config cfg;
+    std::string filter, json_path, baseline_path, value;
+    double threshold = 0.10;
+    bool list_only = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        if (parseOption(a, "--filter", value)) {
+            filter = value;
+        } else if (parseOption(a, "--json", value)) {
+            json_path = value;
+        } else if (parseOption(a, "--baseline", value)) {
+            baseline_path = value;
+        } else if (parseOption(a, "--threshold", value)) {
+            threshold = std::atof(value.c_str());
+        } else if (parseOption(a, "--reps", value)) {
+            cfg.repetitions = std::max(1, std::atoi(value.c_str()));
+        } else if (parseOption(a, "--warmup-ms", value)) {
+            cfg.warmup_ms = std::atof(value.c_str());
+        } else if (parseOption(a, "--min-sample-ms", value)) {
+            cfg.min_sample_ms = std::atof(value.c_str());
+        } else if (parseOption(a, "--max-case-s", value)) {
+            cfg.max_case_s = std::atof(value.c_str());
+        } else if (std::strcmp(a, "--list") == 0) {
+            list_only = true;
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--filter=S] [--json=FILE] [--baseline=FILE] [--threshold=F]"
+                         " [--reps=N] [--warmup-ms=F] [--min-sample-ms=F] [--max-case-s=F]"
+                         " [--list]\n";
+            return 2;
+        }
+    }
+
+    std::vector<bench::Case> selected;
+    for (const bench::Case& c : bench::registry()) {
+        if (filter.empty() || c.name.find(filter) != std::string::npos) {
+            selected.push_back(c);
+        }
+    }
+
+    if (list_only) {
+        for (const bench::Case& c : selected) std::cout << c.name << "\n";
+        return 0;
+    }
+
+    std::cout << "=== Eigen Tutorial Benchmarks ===\n";
+    std::cout << "SIMD: " << simdName() << ", threads: "
+              << std::thread::hardware_concurrency() << ", reps: " << cfg.repetitions << "\n\n";
+
+    char header[200];
+    std::snprintf(header, sizeof(header), "%-52s %12s %12s %10s %12s %12s %14s %10s",
+                  "Case", "median", "mean", "stddev", "p90", "p99", "items/s", "GB/s");
+    std::cout << header << "\n" << std::string(std::strlen(header), '-') << "\n";
+
+    std::vector<Result> results;
+    for (const bench::Case& c : selected) {
+        bench::State state(cfg, c.arg);
+        c.fn(state);
+        Result r{c.name, state.batchSize(), state.samples().size(),
+                 bench::computeStats(state.samples()),
+                 state.itemsPerIteration(), state.bytesPerIteration(), state.counters()};
+        results.push_back(r);
+
+        char line[240];
+        char items[32] = "";
+        char bandwidth[32] = "";
+        if (r.items_per_iter > 0) {
+            std::snprintf(items, sizeof(items), "%.3g", r.items_per_iter * 1e9 / r.stats.median_ns);
+        }
+        if (r.bytes_per_iter > 0) {
+            std::snprintf(bandwidth, sizeof(bandwidth), "%.2f", r.bytes_per_iter / r.stats.median_ns);
+        }
+        double rel_sd = r.stats.mean_ns > 0 ? 100.0 * r.stats.stddev_ns / r.stats.mean_ns : 0.0;
+        char sd[16];
+        std::snprintf(sd, sizeof(sd), "%.1f%%", rel_sd);
+        std::snprintf(line, sizeof(line), "%-52s %12s %12s %10s %12s %12s %14s %10s",
+                      r.name.c_str(), formatTime(r.stats.median_ns).c_str(),
+                      formatTime(r.stats.mean_ns).c_str(), sd,
+                      formatTime(r.stats.p90_ns).c_str(), formatTime(r.stats.p99_ns).c_str(),
+                      items, bandwidth);
+        std::cout << line;
+        for (const auto& cn : r.counters) std::cout << "  " << cn.first << "=" << cn.second;
+        std::cout << std::endl;
+    }
+
+    if (!json_path.empty()) {
+        writeJson(json_path, results, cfg);
+    }
+
+    int exit_code = 0;
+    if (!baseline_path.empty()) {
+        std::map<std::string, double> base = readBaseline(baseline_path);
+        std::cout << "\nComparison against " << baseline_path
+                  << " (median, threshold " << threshold * 100 << "%):\n";
+        for (const Result& r : results) {
+            auto it = base.find(r.name);
+            if (it == base.end() || it->second <= 0) continue;
+            double change = r.stats.median_ns / it->second - 1.0;
+            const char* verdict = change > threshold ? "REGRESSION"
+                                : change < -threshold ? "improved" : "";
+            char line[160];
+            std::snprintf(line, sizeof(line), "  %-52s %12s -> %12s  %+7.1f%%  %s",
+                          r.name.c_str(), formatTime(it->second).c_str(),
+                          formatTime(r.stats.median_ns).c_str(), change * 100, verdict);
+            std::cout << line << "\n";
+            if (change > threshold) exit_code = 1;
+        }
+    }
+
+    return exit_code;
+}
@@ -0,0 +1,73 @@
+/**
+ * Chapter 1.10: Zero-Copy Views over Pose Arrays
+ *
+ * Topics: Eigen::Map with strides, block extraction without copies, bulk ops
+ * SLAM: trajectory logs stored as flat arrays of row-major 4x4 / 3x4 poses
+ */
+
+#include <iostream>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "chapter1/pose_array_view.h"
+
+int main() {
+    std::cout << "=== 1.10 Zero-Copy Pose Array Views ===\n\n";
+
+    // A trajectory log: N row-major 4x4 poses back to back in one buffer
+    const int n = 5;
+    std::vector<double> trajectory(16 * n);
+    for (int i = 0; i < n; ++i) {
+        Eigen::Matrix4d T = Eigen::Matrix4d::Identity();
+        T.block<3,3>(0,0) = Eigen::AngleAxisd(0.1 * i, Eigen::Vector3d::UnitZ()).toRotationMatrix();
+        T.block<3,1>(0,3) = Eigen::Vector3d(i, 2 * i, 0);
+        Eigen::Map<Eigen::Matrix<double, 4, 4, Eigen::RowMajor>> slot(&trajectory[16 * i]);
+        slot = T;
+    }
+
+    eigen_tutorial::PoseArrayView4<double> poses(trajectory.data(), n);
+
+    // Same blocks as 1.5, but mapped onto the buffer instead of copied
+    std::cout << "Pose 2 rotation (mapped):\n" << poses.rotation(2) << "\n\n";
+    std::cout << "Pose 2 translation (mapped): " << poses.translation(2).transpose() << "\n\n";
+
+    // All translations as one 3xN matrix view (strides: 16 between poses, 4 between rows)
+    std::cout << "All translations (3xN view):\n" << poses.translations() << "\n\n";
+
+    // Element (0,0) of every rotation, i.e. cos(theta_i), as one strided vector
+    std::cout << "R(0,0) of every pose: " << poses.entry(0, 0).transpose() << "\n\n";
+
+    // Writes go straight into the buffer
+    poses.translation(0) = Eigen::Vector3d(-1, -1, -1);
+    std::cout << "trajectory[3], [7], [11] after write: "
+              << trajectory[3] << ", " << trajectory[7] << ", " << trajectory[11] << "\n\n";
+
+    // Range-for over poses
+    std::cout << "Heading of each pose (atan2 of R(1,0), R(0,0)):\n";
+    for (auto T : poses) {
+        std::cout << "  " << std::atan2(T(1, 0), T(0, 0)) << "\n";
+    }
+    std::cout << "\n";
+
+    // Bulk: forward axis of every pose, R_i * [1 0 0]
+    Eigen::Matrix<double, 3, Eigen::Dynamic> forward;
+    poses.rotate(Eigen::Vector3d::UnitX(), forward);
+    std::cout << "R_i * x_axis:\n" << forward << "\n\n";
+
+    // Bulk: all translations into SoA buffers (see 1.8)
+    eigen_tutorial::PointCloudSoA<double> positions;
+    poses.translationsToSoA(positions);
+    std::cout << "Positions x: " << positions.x.transpose() << "\n\n";
+
+    // 3x4 logs (KITTI style) work the same way; const views are read-only
+    std::vector<double> kitti(12 * n, 0.0);
+    for (int i = 0; i < n; ++i) {
+        kitti[12 * i + 0] = kitti[12 * i + 5] = kitti[12 * i + 10] = 1.0;
+        kitti[12 * i + 11] = 0.5 * i;  // z translation
+    }
+    eigen_tutorial::PoseArrayView34<const double> kitti_poses(kitti.data(), n);
+    std::cout << "3x4 log translations:\n" << kitti_poses.translations() << "\n";
+
+    return 0;
+}
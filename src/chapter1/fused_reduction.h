@@ -0,0 +1,170 @@
+/**
+ * Single-pass fused reductions (see 1.9)
+ *
+ * 1.6 calls minCoeff(), maxCoeff(), sum() and mean() one after another; each
+ * call streams the whole array from memory again. For arrays far larger than
+ * the caches that is N passes of pure memory traffic for N statistics.
+ *
+ * fusedReduce() reads memory once. The data is walked in blocks small enough
+ * to stay in L1/L2; inside a block Eigen's vectorized reductions run for each
+ * requested statistic (cheap, the block is cached), and block results are
+ * merged into running totals. Threads each take a contiguous range and their
+ * partial results are merged in order, so results do not depend on timing.
+ *
+ * Variance uses a two-pass sum of squared deviations inside each block and
+ * Chan et al.'s pairwise update between blocks and threads:
+ *   n   = n_a + n_b,  d = mean_b - mean_a
+ *   mean = mean_a + d * n_b / n
+ *   M2   = M2_a + M2_b + d^2 * n_a * n_b / n
+ * which avoids the catastrophic cancellation of E[x^2] - E[x]^2.
+ *
+ * Accumulation is in double for both float and double input.
+ * argmin / argmax report the first occurrence, like minCoeff(&index).
+ */
+
+#ifndef EIGEN_TUTORIAL_FUSED_REDUCTION_H
+#define EIGEN_TUTORIAL_FUSED_REDUCTION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include <Eigen/Dense>
+
+#include "common/parallel.h"
+
+namespace eigen_tutorial {
+
+enum ReductionFlags : unsigned {
+    kReduceSum = 1u << 0,
+    kReduceMean = 1u << 1,
+    kReduceMin = 1u << 2,
+    kReduceMax = 1u << 3,
+    kReduceArgMin = 1u << 4,
+    kReduceArgMax = 1u << 5,
+    kReduceVariance = 1u << 6,
+    kReduceAll = (1u << 7) - 1
+};
+
+struct ReductionStats {
+    Eigen::Index count = 0;
+    double sum = 0;
+    double mean = 0;
+    double m2 = 0;  // Sum of squared deviations from the mean
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    Eigen::Index argmin = -1;
+    Eigen::Index argmax = -1;
+
+    double variance() const { return count > 0 ? m2 / count : 0.0; }
+    double sampleVariance() const { return count > 1 ? m2 / (count - 1) : 0.0; }
+
+    // Combine with the statistics of the elements that follow this range
+    void merge(const ReductionStats& b) {
+        if (b.count == 0) return;
+        if (count == 0) {
+            *this = b;
+            return;
+        }
+        double n = static_cast<double>(count + b.count);
+        double d = b.mean - mean;
+        mean += d * b.count / n;
+        m2 += b.m2 + d * d * (static_cast<double>(count) * b.count / n);
+        sum += b.sum;
+        count += b.count;
+        // Strict comparison keeps the earlier index on ties
+        if (b.min < min) {
+            min = b.min;
+            argmin = b.argmin;
+        }
+        if (b.max > max) {
+            max = b.max;
+            argmax = b.argmax;
+        }
+    }
+};
+
+// Elements per block; 4096 doubles = 32 KB, roughly one L1 data cache
+const Eigen::Index kReductionBlock = 4096;
+
+// Below this many elements per thread, threads cost more than they save
+const size_t kReductionMinChunk = 1 << 18;
+
+namespace detail {
+
+// Block statistics; argmin/argmax are located separately (see reduceRange)
+template <typename Scalar>
+ReductionStats reduceBlock(const Scalar* data, Eigen::Index n, unsigned what) {
+    Eigen::Map<const Eigen::Array<Scalar, Eigen::Dynamic, 1>> b(data, n);
+    ReductionStats s;
+    s.count = n;
+    if (what & (kReduceSum | kReduceMean | kReduceVariance)) {
+        s.sum = b.template cast<double>().sum();
+        s.mean = s.sum / n;
+    }
+    if (what & kReduceVariance) {
+        s.m2 = (b.template cast<double>() - s.mean).square().sum();
+    }
+    if (what & (kReduceMin | kReduceArgMin)) s.min = b.minCoeff();
+    if (what & (kReduceMax | kReduceArgMax)) s.max = b.maxCoeff();
+    return s;
+}
+
+template <typename Scalar>
+Eigen::Index firstIndexOf(const Scalar* data, Eigen::Index n, double value) {
+    return static_cast<Eigen::Index>(std::find(data, data + n, static_cast<Scalar>(value)) - data);
+}
+
+template <typename Scalar>
+ReductionStats reduceRange(const Scalar* data, size_t begin, size_t end, unsigned what) {
+    ReductionStats s;
+    for (size_t i = begin; i < end; i += kReductionBlock) {
+        Eigen::Index len = static_cast<Eigen::Index>(std::min<size_t>(kReductionBlock, end - i));
+        ReductionStats b = reduceBlock(data + i, len, what);
+        // minCoeff(&index) is not vectorized. Use the vectorized min instead and
+        // search the (cached) block only when it beats the running minimum,
+        // which for most data happens in a handful of blocks.
+        if ((what & kReduceArgMin) && b.min < s.min) {
+            b.argmin = static_cast<Eigen::Index>(i) + firstIndexOf(data + i, len, b.min);
+        }
+        if ((what & kReduceArgMax) && b.max > s.max) {
+            b.argmax = static_cast<Eigen::Index>(i) + firstIndexOf(data + i, len, b.max);
+        }
+        s.merge(b);
+    }
+    return s;
+}
+
+}  // namespace detail
+
+// Computes the requested statistics (any OR of ReductionFlags) over n values
+// in one pass over memory. Statistics that were not requested are left at
+// their defaults; asking for mean or variance also fills in sum and mean.
+template <typename Scalar>
+ReductionStats fusedReduce(const Scalar* data, size_t n, unsigned what = kReduceAll) {
+    // Chunk boundaries on block multiples so threads see whole blocks
+    int chunks = chunkCount(n, kReductionMinChunk);
+    std::vector<ReductionStats> partial(chunks);
+    forChunks(n, chunks, [&](int c, size_t b, size_t e) {
+        partial[c] = detail::reduceRange(data, b, e, what);
+    }, kReductionBlock);
+    ReductionStats total;
+    for (const ReductionStats& p : partial) total.merge(p);
+    return total;
+}
+
+// Any Matrix / Array (contiguous storage), all coefficients
+template <typename Derived>
+ReductionStats fusedReduce(const Eigen::PlainObjectBase<Derived>& m, unsigned what = kReduceAll) {
+    return fusedReduce(m.data(), static_cast<size_t>(m.size()), what);
+}
+
+// Maps over caller-owned buffers (default, i.e. contiguous, stride)
+template <typename PlainType, int MapOptions>
+ReductionStats fusedReduce(const Eigen::Map<PlainType, MapOptions>& m, unsigned what = kReduceAll) {
+    return fusedReduce(m.data(), static_cast<size_t>(m.size()), what);
+}
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_FUSED_REDUCTION_H
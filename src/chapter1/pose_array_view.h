@@ -0,0 +1,149 @@
+/**
+ * Zero-copy views over flat arrays of poses (see 1.10)
+ *
+ * 1.5 extracts rotation and translation from one Matrix4d with block<3,3>()
+ * and block<3,1>(). Trajectory logs usually arrive as one flat buffer of N
+ * row-major 4x4 (or 3x4) poses:
+ *
+ *   pose i:  data[P*i + 4*r + c],  P = 16 (4x4) or 12 (3x4)
+ *
+ * Instead of copying each pose into a Matrix4d, PoseArrayView hands out
+ * Eigen::Map objects with strides that point straight into that buffer:
+ *
+ *   pose(i)          Rows x 4 matrix            (one pose)
+ *   rotation(i)      3x3, outer stride 4        (block<3,3>(0,0) of pose i)
+ *   translation(i)   3x1, inner stride 4        (block<3,1>(0,3) of pose i)
+ *   translations()   3xN, strides (P, 4)        (all translations at once)
+ *   entry(r, c)      N-vector, inner stride P   (element (r,c) of every pose)
+ *
+ * Whole-array maps are ordinary Eigen expressions (e.g. translations().rowwise()
+ * .mean()); the bulk operations below (rotate, transform, translationsToSoA)
+ * run directly on the mapped memory without materializing any Matrix4d.
+ *
+ * Scalar may be const-qualified for read-only views: PoseArrayView<const double, 4>.
+ */
+
+#ifndef EIGEN_TUTORIAL_POSE_ARRAY_VIEW_H
+#define EIGEN_TUTORIAL_POSE_ARRAY_VIEW_H
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <Eigen/Dense>
+
+#include "chapter1/soa_transform.h"
+
+namespace eigen_tutorial {
+
+template <typename Scalar, int Rows>
+class PoseArrayView {
+    static_assert(Rows == 3 || Rows == 4, "Poses are 3x4 or 4x4");
+
+public:
+    typedef typename std::remove_const<Scalar>::type PlainScalar;
+    static const int kPoseSize = Rows * 4;
+    static const size_t kBulkMinChunk = 1 << 15;  // Poses per thread, at least
+
+    // Apply the view's constness to a plain matrix type
+    template <typename Plain>
+    using Qualified = typename std::conditional<std::is_const<Scalar>::value, const Plain, Plain>::type;
+
+    typedef Eigen::Map<Qualified<Eigen::Matrix<PlainScalar, Rows, 4, Eigen::RowMajor>>> PoseMap;
+    typedef Eigen::Map<Qualified<Eigen::Matrix<PlainScalar, 3, 3, Eigen::RowMajor>>, 0,
+                       Eigen::OuterStride<4>> RotationMap;
+    typedef Eigen::Map<Qualified<Eigen::Matrix<PlainScalar, 3, 1>>, 0,
+                       Eigen::InnerStride<4>> TranslationMap;
+    typedef Eigen::Map<Qualified<Eigen::Matrix<PlainScalar, 3, Eigen::Dynamic>>, 0,
+                       Eigen::Stride<kPoseSize, 4>> TranslationsMap;
+    typedef Eigen::Map<Qualified<Eigen::Matrix<PlainScalar, Eigen::Dynamic, 1>>, 0,
+                       Eigen::InnerStride<kPoseSize>> EntryMap;
+
+    PoseArrayView(Scalar* data, Eigen::Index n) : data_(data), n_(n) {}
+
+    Eigen::Index size() const { return n_; }
+    Scalar* data() const { return data_; }
+
+    PoseMap pose(Eigen::Index i) const { return PoseMap(data_ + kPoseSize * i); }
+    RotationMap rotation(Eigen::Index i) const { return RotationMap(data_ + kPoseSize * i); }
+    TranslationMap translation(Eigen::Index i) const { return TranslationMap(data_ + kPoseSize * i + 3); }
+
+    TranslationsMap translations() const { return TranslationsMap(data_ + 3, 3, n_); }
+    EntryMap entry(int r, int c) const { return EntryMap(data_ + 4 * r + c, n_); }
+
+    // Range-for over poses: for (auto T : view) { T.block<3,3>(0,0) ... }
+    class iterator {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef PoseMap value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef void pointer;
+        typedef PoseMap reference;
+
+        explicit iterator(Scalar* p) : p_(p) {}
+        PoseMap operator*() const { return PoseMap(p_); }
+        PoseMap operator[](difference_type k) const { return PoseMap(p_ + kPoseSize * k); }
+        iterator& operator++() { p_ += kPoseSize; return *this; }
+        iterator operator++(int) { iterator t = *this; p_ += kPoseSize; return t; }
+        iterator& operator--() { p_ -= kPoseSize; return *this; }
+        iterator& operator+=(difference_type k) { p_ += kPoseSize * k; return *this; }
+        iterator operator+(difference_type k) const { return iterator(p_ + kPoseSize * k); }
+        difference_type operator-(const iterator& o) const { return (p_ - o.p_) / kPoseSize; }
+        bool operator==(const iterator& o) const { return p_ == o.p_; }
+        bool operator!=(const iterator& o) const { return p_ != o.p_; }
+        bool operator<(const iterator& o) const { return p_ < o.p_; }
+
+    private:
+        Scalar* p_;
+    };
+
+    iterator begin() const { return iterator(data_); }
+    iterator end() const { return iterator(data_ + kPoseSize * n_); }
+
+    // Bulk operations walk the buffer once, pose by pose, through the mapped
+    // blocks. (Row-wise expressions over entry() maps would be shorter but
+    // stream the whole buffer once per entry.)
+
+    // out.col(i) = R_i * v
+    void rotate(const Eigen::Matrix<PlainScalar, 3, 1>& v,
+                Eigen::Matrix<PlainScalar, 3, Eigen::Dynamic>& out) const {
+        out.resize(3, n_);
+        parallelFor(static_cast<size_t>(n_), kBulkMinChunk, [&](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) out.col(i).noalias() = rotation(i) * v;
+        });
+    }
+
+    // out.col(i) = R_i * p + t_i, e.g. one landmark expressed by every pose
+    void transform(const Eigen::Matrix<PlainScalar, 3, 1>& p,
+                   Eigen::Matrix<PlainScalar, 3, Eigen::Dynamic>& out) const {
+        out.resize(3, n_);
+        parallelFor(static_cast<size_t>(n_), kBulkMinChunk, [&](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) out.col(i).noalias() = rotation(i) * p + translation(i);
+        });
+    }
+
+    // Gather all translations into contiguous SoA buffers
+    void translationsToSoA(PointCloudSoA<PlainScalar>& out) const {
+        out.resize(n_);
+        parallelFor(static_cast<size_t>(n_), kBulkMinChunk, [&](size_t b, size_t e) {
+            const Scalar* p = data_ + kPoseSize * b + 3;
+            for (size_t i = b; i < e; ++i, p += kPoseSize) {
+                out.x[i] = p[0];
+                out.y[i] = p[4];
+                out.z[i] = p[8];
+            }
+        });
+    }
+
+private:
+    Scalar* data_;
+    Eigen::Index n_;
+};
+
+template <typename Scalar>
+using PoseArrayView4 = PoseArrayView<Scalar, 4>;
+template <typename Scalar>
+using PoseArrayView34 = PoseArrayView<Scalar, 3>;
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_POSE_ARRAY_VIEW_H
@@ -3,6 +3,8 @@
  *
  * Topics: A = U * S * V^T, rank, pseudo-inverse
  * SLAM Applications: Essential/Fundamental matrix, point cloud alignment, null space
+ *
+ * For the leading singular values of large matrices, 2.16 avoids the full SVD
  */
 
 #include <iostream>
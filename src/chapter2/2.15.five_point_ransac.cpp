@@ -0,0 +1,106 @@
+/**
+ * Chapter 2.15: Five-Point Relative Pose with RANSAC
+ *
+ * Topics: Minimal essential-matrix solver (action matrix + eigenvectors),
+ *         preemptive RANSAC with Sampson scoring, cheirality check
+ * SLAM Applications: Visual odometry initialization, two-view geometry,
+ *                    loop-closure verification
+ */
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "chapter2/five_point.h"
+#include "chapter3/lie_group.h"
+
+namespace {
+
+double msSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+}  // namespace
+
+int main() {
+    std::cout << "=== 2.15 Five-Point Relative Pose with RANSAC ===\n\n";
+
+    // Second camera: 5 degrees of yaw, moving forward and to the side
+    // (x2 = R * x1 + t, as in 2.7)
+    const Eigen::Matrix3d R_true =
+        Eigen::AngleAxisd(5 * M_PI / 180, Eigen::Vector3d(0.1, 1, 0.05).normalized()).toRotationMatrix();
+    const Eigen::Vector3d t_true = Eigen::Vector3d(0.3, 0.05, -1).normalized();
+    const Eigen::Matrix3d E_true = eigen_tutorial::skew(t_true) * R_true;
+
+    // 2000 points 4-20 m in front of the first camera, 500 px focal length
+    const int n = 2000;
+    const double focal = 500;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    std::normal_distribution<double> pixel_noise(0.0, 0.5);
+    Eigen::Matrix2Xd x1(2, n), x2(2, n);
+    for (int i = 0; i < n; ++i) {
+        const Eigen::Vector3d X(8 * u(rng), 6 * u(rng), 12 + 8 * u(rng));
+        const Eigen::Vector3d Y = R_true * X + t_true;
+        x1.col(i) = X.hnormalized() + Eigen::Vector2d(pixel_noise(rng), pixel_noise(rng)) / focal;
+        x2.col(i) = Y.hnormalized() + Eigen::Vector2d(pixel_noise(rng), pixel_noise(rng)) / focal;
+    }
+    // 40% of the matches are wrong
+    std::vector<bool> outlier(n, false);
+    for (int i = 0; i < n; i += 5) {
+        for (int k = i; k < i + 2 && k < n; ++k) {
+            x2.col(k) = Eigen::Vector2d(0.6 * u(rng), 0.45 * u(rng));
+            outlier[k] = true;
+        }
+    }
+
+    // The minimal solver on 5 noise-free inliers: one root is the true E
+    Eigen::Matrix<double, 2, 5> a, b;
+    for (int i = 0; i < 5; ++i) {
+        const Eigen::Vector3d X(8 * u(rng), 6 * u(rng), 12 + 8 * u(rng));
+        a.col(i) = X.hnormalized();
+        b.col(i) = (R_true * X + t_true).hnormalized();
+    }
+    Eigen::Matrix3d E[10];
+    auto t0 = std::chrono::steady_clock::now();
+    const int reps = 1000;
+    int roots = 0;
+    for (int r = 0; r < reps; ++r) roots = eigen_tutorial::fivePoint(a, b, E);
+    const double solve_us = msSince(t0) * 1000 / reps;
+    double best = 1e9;
+    for (int k = 0; k < roots; ++k) {
+        const Eigen::Matrix3d Et = E_true / E_true.norm();
+        best = std::min(best, std::min((E[k] - Et).norm(), (E[k] + Et).norm()));
+    }
+    std::cout << "fivePoint: " << roots << " real solutions in " << solve_us << " us, "
+              << "closest to the true E: " << best << "\n\n";
+
+    // RANSAC with a 1.5 px threshold
+    eigen_tutorial::EssentialRansacOptions options;
+    options.threshold = 1.5 / focal;
+    eigen_tutorial::EssentialRansac ransac(options);
+    for (int preemptive = 1; preemptive >= 0; --preemptive) {
+        options.preemptive_block = preemptive ? 100 : 0;
+        ransac.setOptions(options);
+        t0 = std::chrono::steady_clock::now();
+        eigen_tutorial::EssentialResult r = ransac.estimate(x1, x2);
+        const double ms = msSince(t0);
+
+        int false_in = 0;
+        for (int i = 0; i < n; ++i) false_in += r.inliers[i] && outlier[i];
+        const double rot_err = Eigen::AngleAxisd(r.R * R_true.transpose()).angle() * 180 / M_PI;
+        const double t_err = std::acos(std::min(1.0, r.t.dot(t_true))) * 180 / M_PI;
+        std::cout << (preemptive ? "Preemptive scoring" : "Full scoring") << ": " << ms << " ms, "
+                  << r.samples << " samples, " << r.hypotheses << " hypotheses, "
+                  << eigen_tutorial::numThreads() << " threads\n"
+                  << "    " << r.num_inliers << " inliers (" << false_in << " of them outliers), "
+                  << r.num_in_front << " in front of both cameras\n"
+                  << "    rotation error " << rot_err << " deg, translation direction error " << t_err
+                  << " deg\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * Chapter 2.17: Tall-Skinny QR (TSQR)
+ *
+ * Topics: QR by row blocks, tree reduction of R factors, streaming least
+ *         squares, normal equations vs QR accuracy
+ * SLAM Applications: Calibration with millions of residuals, line / plane
+ *                    fitting on full scans, out-of-core least squares
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+#include <Eigen/Dense>
+
+#include "chapter2/tsqr.h"
+
+namespace {
+
+double msSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Rows of a degree-(n-1) polynomial fit in t in [0, 1]: the monomial basis
+// makes A badly conditioned (~1e7 for n = 12), as in real calibration models
+void polynomialRows(Eigen::Index first, Eigen::Index count, Eigen::Index m, Eigen::Index n,
+                    const Eigen::VectorXd& x_true, Eigen::MatrixXd& A, Eigen::VectorXd& y) {
+    A.resize(count, n);
+    for (Eigen::Index i = 0; i < count; ++i) {
+        const double t = static_cast<double>(first + i) / (m - 1);
+        double p = 1;
+        for (Eigen::Index j = 0; j < n; ++j, p *= t) A(i, j) = p;
+    }
+    // Deterministic "noise" so that streamed and in-memory rows agree
+    y = A * x_true;
+    for (Eigen::Index i = 0; i < count; ++i) y(i) += 1e-6 * std::sin(1e3 * static_cast<double>(first + i));
+}
+
+}  // namespace
+
+int main() {
+    std::cout << "=== 2.17 Tall-Skinny QR (TSQR) ===\n\n";
+
+    const Eigen::Index m = 2000000, n = 12;
+    Eigen::VectorXd x_true = Eigen::VectorXd::LinSpaced(n, 1, -1);
+    Eigen::MatrixXd A;
+    Eigen::VectorXd y;
+    polynomialRows(0, m, m, n, x_true, A, y);
+    std::cout << m << " x " << n << " least squares, " << eigen_tutorial::numThreads() << " threads\n\n";
+
+    auto t0 = std::chrono::steady_clock::now();
+    Eigen::VectorXd x_ne = (A.transpose() * A).ldlt().solve(A.transpose() * y);
+    const double ne_ms = msSince(t0);
+    t0 = std::chrono::steady_clock::now();
+    Eigen::VectorXd x_qr = A.householderQr().solve(y);
+    const double qr_ms = msSince(t0);
+    t0 = std::chrono::steady_clock::now();
+    double residual = 0;
+    Eigen::VectorXd x_tsqr = eigen_tutorial::tsqrLeastSquares(A, y, &residual);
+    const double tsqr_ms = msSince(t0);
+
+    auto report = [&](const char* name, const Eigen::VectorXd& x, double ms) {
+        std::cout << name << ms << " ms, |x - x_true| / |x_true| = " << (x - x_true).norm() / x_true.norm()
+                  << "\n";
+    };
+    report("Normal equations: ", x_ne, ne_ms);
+    report("HouseholderQR:    ", x_qr, qr_ms);
+    report("TSQR:             ", x_tsqr, tsqr_ms);
+    std::cout << "TSQR residual norm " << residual << " vs |A x - y| = " << (A * x_tsqr - y).norm() << "\n\n";
+
+    // R agrees with HouseholderQR's up to the signs of its rows
+    Eigen::MatrixXd R_tsqr = eigen_tutorial::tsqrR(A);
+    Eigen::MatrixXd R_qr = A.householderQr().matrixQR().topRows(n).triangularView<Eigen::Upper>();
+    Eigen::VectorXd signs = (R_tsqr.diagonal().array() * R_qr.diagonal().array()).sign().matrix();
+    std::cout << "max |R_tsqr - R_householder| (sign-corrected) = "
+              << (signs.asDiagonal() * R_tsqr - R_qr).cwiseAbs().maxCoeff() << "\n\n";
+
+    // Streaming: write the rows to disk in blocks, then read them back one
+    // block at a time; only R and one block are ever in memory
+    const Eigen::Index block = 100000;
+    std::FILE* file = std::tmpfile();
+    if (!file) {
+        std::cout << "No temporary file available, skipping the streaming example\n";
+        return 0;
+    }
+    for (Eigen::Index b = 0; b < m; b += block) {
+        Eigen::MatrixXd Ab;
+        Eigen::VectorXd yb;
+        polynomialRows(b, std::min(block, m - b), m, n, x_true, Ab, yb);
+        Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> rows(Ab.rows(), n + 1);
+        rows << Ab, yb;
+        std::fwrite(rows.data(), sizeof(double), rows.size(), file);
+    }
+    std::rewind(file);
+
+    t0 = std::chrono::steady_clock::now();
+    eigen_tutorial::TsqrAccumulator acc(n + 1);
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> rows(block, n + 1);
+    size_t read;
+    while ((read = std::fread(rows.data(), sizeof(double) * (n + 1), block, file)) > 0) {
+        acc.addRows(rows.topRows(static_cast<Eigen::Index>(read)));
+    }
+    std::fclose(file);
+    Eigen::VectorXd x_stream = acc.solve(&residual);
+    std::cout << "Streamed " << acc.rowsAdded() << " rows from disk in " << msSince(t0) << " ms, "
+              << "|x - x_tsqr| = " << (x_stream - x_tsqr).norm() << ", residual " << residual << "\n";
+
+    return 0;
+}
@@ -3,6 +3,8 @@
  *
  * Topics: A = Q * R, Q orthogonal, R upper triangular
  * SLAM Applications: Least squares, numerical stability, orthogonalization
+ *
+ * QR of tall matrices by row blocks, across threads or streamed from disk: 2.17
  */
 
 #include <iostream>
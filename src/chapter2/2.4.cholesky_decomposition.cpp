@@ -3,6 +3,8 @@
  *
  * Topics: A = L * L^T for positive definite matrices
  * SLAM Applications: Covariance matrices, Kalman filter, sampling from Gaussian
+ *
+ * For millions of samples from one covariance, 2.14 factors once and samples in blocks
  */
 
 #include <iostream>
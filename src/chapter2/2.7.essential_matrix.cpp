@@ -3,6 +3,8 @@
  *
  * Topics: Essential matrix properties, SVD constraint enforcement
  * SLAM Applications: Stereo vision, visual odometry, epipolar geometry
+ *
+ * Estimating E from point correspondences (five-point solver + RANSAC): 2.15
  */
 
 #include <iostream>
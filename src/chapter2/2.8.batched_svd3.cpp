@@ -0,0 +1,89 @@
+/**
+ * Chapter 2.8: Batched 3x3 SVD
+ *
+ * Topics: Branch-free Jacobi SVD, SIMD across matrices, accuracy vs sweeps
+ * SLAM Applications: RANSAC / loop-closure verification (many Procrustes
+ *                    alignments and essential-matrix projections per second)
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "chapter2/batched_svd3.h"
+
+int main() {
+    std::cout << "=== 2.8 Batched 3x3 SVD ===\n\n";
+
+    // Cross-covariance matrices H = sum p_i q_i^T as in 2.2, one per hypothesis
+    const size_t n = 20000;
+    std::vector<Eigen::Matrix3d> H(n), R_true(n);
+    for (size_t m = 0; m < n; ++m) {
+        R_true[m] = Eigen::Quaterniond::UnitRandom().toRotationMatrix();
+        Eigen::Matrix<double, 3, 8> P = Eigen::Matrix<double, 3, 8>::Random();
+        Eigen::Matrix<double, 3, 8> Q = R_true[m] * P + 0.01 * Eigen::Matrix<double, 3, 8>::Random();
+        Eigen::Vector3d cp = P.rowwise().mean(), cq = Q.rowwise().mean();
+        H[m] = (P.colwise() - cp) * (Q.colwise() - cq).transpose();
+    }
+
+    // One matrix: compare with JacobiSVD
+    std::vector<Eigen::Matrix3d> U(n), V(n);
+    std::vector<Eigen::Vector3d> S(n);
+    eigen_tutorial::batchedSvd3(H.data(), n, U.data(), S.data(), V.data());
+
+    Eigen::JacobiSVD<Eigen::Matrix3d> svd(H[0], Eigen::ComputeFullU | Eigen::ComputeFullV);
+    std::cout << "JacobiSVD singular values: " << svd.singularValues().transpose() << "\n";
+    std::cout << "Batched singular values:   " << S[0].transpose()
+              << "  (sigma2 carries sign(det H) = " << (H[0].determinant() < 0 ? "-" : "+") << ")\n";
+    std::cout << "det(U) = " << U[0].determinant() << ", det(V) = " << V[0].determinant()
+              << "  (always proper rotations)\n";
+    std::cout << "||U S V^T - H|| = "
+              << (U[0] * S[0].asDiagonal() * V[0].transpose() - H[0]).norm() << "\n\n";
+
+    // Same rotation as 2.2: R = V U^T, reflection already handled by the signs
+    std::vector<Eigen::Matrix3d> R(n);
+    eigen_tutorial::batchedProcrustesRotation(H.data(), n, R.data());
+    Eigen::Matrix3d R22 = svd.matrixV() * svd.matrixU().transpose();
+    if (R22.determinant() < 0) {
+        Eigen::Matrix3d V_fixed = svd.matrixV();
+        V_fixed.col(2) *= -1;
+        R22 = V_fixed * svd.matrixU().transpose();
+    }
+    std::cout << "||R_batched - R_2.2|| for matrix 0: " << (R[0] - R22).norm() << "\n\n";
+
+    // Accuracy against throughput: fixed sweeps, no convergence test
+    std::cout << "sweeps  max|sigma - JacobiSVD|  max||R - R_true||  time per matrix\n";
+    std::vector<Eigen::Vector3d> S_ref(n);
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t m = 0; m < n; ++m) {
+        S_ref[m] = Eigen::JacobiSVD<Eigen::Matrix3d>(H[m]).singularValues();
+    }
+    double jacobi_ns = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - t0).count() / n;
+
+    for (int sweeps = 2; sweeps <= 6; ++sweeps) {
+        auto t1 = std::chrono::steady_clock::now();
+        eigen_tutorial::batchedSvd3(H.data(), n, U.data(), S.data(), V.data(), sweeps);
+        double ns = std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - t1).count() / n;
+        eigen_tutorial::batchedProcrustesRotation(H.data(), n, R.data(), sweeps);
+
+        double sigma_err = 0, rot_err = 0;
+        for (size_t m = 0; m < n; ++m) {
+            Eigen::Vector3d s = S[m];
+            s(2) = std::abs(s(2));
+            sigma_err = std::max(sigma_err, (s - S_ref[m]).cwiseAbs().maxCoeff() / S_ref[m](0));
+            rot_err = std::max(rot_err, (R[m] - R_true[m]).norm());
+        }
+        std::cout << "  " << sweeps << "     " << sigma_err << "            " << rot_err
+                  << "          " << ns << " ns\n";
+    }
+    std::cout << "JacobiSVD (values only):                             " << jacobi_ns << " ns\n\n";
+
+    std::cout << "(rotation error is dominated by the 0.01 noise added to Q, not by the SVD)\n";
+
+    return 0;
+}
@@ -0,0 +1,273 @@
+/**
+ * Batched branch-free 3x3 SVD (see 2.8)
+ *
+ * 2.2 and 2.7 run JacobiSVD<Matrix3d> on one matrix at a time. RANSAC and
+ * loop-closure checks need tens of thousands of them, which is a good fit for
+ * SIMD: give every lane its own matrix and run the same instruction stream
+ * on all of them. That only works without data-dependent branches, so this
+ * follows McAdams et al., "Computing the Singular Value Decomposition of 3x3
+ * matrices with minimal branching and elementary floating point operations":
+ *
+ *   1. Eigen-decompose S = A^T A with a FIXED number of Jacobi sweeps. Each
+ *      Jacobi rotation uses an approximate Givens angle (no trig, no branch)
+ *      and is accumulated into V as a quaternion.
+ *   2. B = A V; sort the columns of B by norm, swapping columns with a sign
+ *      flip so that V stays a proper rotation.
+ *   3. QR-factor B with three Givens rotations: B = U R, R ~ diag(sigma).
+ *
+ * Every "if" is a select() on Eigen arrays holding one matrix per lane.
+ *
+ * Result: A = U diag(sigma) V^T with U, V proper rotations (det = +1) and
+ * sigma0 >= sigma1 >= |sigma2|. sigma2 carries the sign of det(A). This is
+ * exactly what the Procrustes / Kabsch problem in 2.2 needs: R = V U^T is
+ * always a rotation, identical to 2.2's "flip the last column of V when
+ * det(R) < 0" correction. Use toStandardSvd() for JacobiSVD conventions.
+ */
+
+#ifndef EIGEN_TUTORIAL_BATCHED_SVD3_H
+#define EIGEN_TUTORIAL_BATCHED_SVD3_H
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <Eigen/Dense>
+
+#include "common/parallel.h"
+
+namespace eigen_tutorial {
+
+// One 512-bit register worth of matrices per batch
+template <typename Scalar>
+struct Svd3Lanes {
+    enum { value = 64 / sizeof(Scalar) };
+};
+
+// 4 sweeps are enough for float; double needs a few more to reach ~1e-15
+template <typename Scalar>
+struct Svd3DefaultSweeps {
+    enum { value = sizeof(Scalar) == 4 ? 4 : 6 };
+};
+
+namespace detail {
+
+// One Jacobi conjugation S <- G^T S G in the (p, q) plane, (p, q, k) cyclic,
+// with the rotation appended to the quaternion (qw, qv).
+template <typename Lane>
+inline void svd3Jacobi(int p, int q, int k, Lane S[3][3], Lane& qw, Lane qv[3]) {
+    typedef typename Lane::Scalar Scalar;
+    const Scalar gamma = Scalar(5.828427124746190);   // 3 + 2 sqrt(2)
+    const Scalar cstar = Scalar(0.9238795325112867);  // cos(pi / 8)
+    const Scalar sstar = Scalar(0.3826834323650898);  // sin(pi / 8)
+
+    Lane a = S[p][p], d = S[q][q], b = S[p][q];
+
+    // Half-angle (cos, sin) of the rotation that annihilates S_pq, to first
+    // order: tan(phi) = S_pq / (2 (S_pp - S_qq)). Clamp to pi/8 when that
+    // estimate would be too large (S_pp ~ S_qq).
+    Lane ch = Scalar(2) * (a - d);
+    Lane sh = b;
+    Lane w = (ch.square() + sh.square()).rsqrt();
+    // Evaluated now: ch and sh are overwritten below
+    const auto accurate = (gamma * sh.square() < ch.square()).eval();
+    ch = accurate.select(w * ch, Lane::Constant(cstar));
+    sh = accurate.select(w * sh, Lane::Constant(sstar));
+
+    Lane c = ch.square() - sh.square();
+    Lane s = Scalar(2) * ch * sh;
+    Lane cc = c * c, ss = s * s, cs = c * s;
+
+    Lane spk = S[p][k], sqk = S[q][k];
+    S[p][p] = cc * a + Scalar(2) * cs * b + ss * d;
+    S[q][q] = ss * a - Scalar(2) * cs * b + cc * d;
+    S[p][q] = S[q][p] = b * (cc - ss) + cs * (d - a);
+    S[p][k] = S[k][p] = c * spk + s * sqk;
+    S[q][k] = S[k][q] = c * sqk - s * spk;
+
+    // q <- q * (ch, sh e_k)
+    Lane w0 = qw, vp = qv[p], vq = qv[q], vk = qv[k];
+    qw = ch * w0 - sh * vk;
+    qv[p] = ch * vp + sh * vq;
+    qv[q] = ch * vq - sh * vp;
+    qv[k] = ch * vk + sh * w0;
+}
+
+// Swap columns i, j of B and V when cond, negating one to keep det(V) = +1
+template <typename Lane, typename Cond>
+inline void svd3CondSwap(const Cond& cond, int i, int j, Lane B[3][3], Lane V[3][3], Lane rho[3]) {
+    for (int r = 0; r < 3; ++r) {
+        Lane bi = B[r][i], vi = V[r][i];
+        B[r][i] = cond.select(B[r][j], bi);
+        B[r][j] = cond.select(-bi, B[r][j]);
+        V[r][i] = cond.select(V[r][j], vi);
+        V[r][j] = cond.select(-vi, V[r][j]);
+    }
+    Lane ri = rho[i];
+    rho[i] = cond.select(rho[j], ri);
+    rho[j] = cond.select(ri, rho[j]);
+}
+
+// Givens rotation in the (p, q) plane that zeroes B[q][p]: B <- G^T B, U <- U G
+template <typename Lane>
+inline void svd3QrGivens(int p, int q, Lane B[3][3], Lane U[3][3]) {
+    typedef typename Lane::Scalar Scalar;
+    const Scalar eps = std::sqrt(std::numeric_limits<Scalar>::min());
+
+    Lane a1 = B[p][p], a2 = B[q][p];
+    Lane rho = (a1.square() + a2.square()).sqrt();
+    Lane sh = (rho > eps).select(a2, Lane::Zero());
+    Lane ch = a1.abs() + rho.max(eps);
+    // For a1 < 0 use the complementary half angle; avoids cancellation in a1 + rho
+    const auto flip = (a1 < Scalar(0)).eval();
+    Lane t = ch;
+    ch = flip.select(sh, ch);
+    sh = flip.select(t, sh);
+    Lane w = (ch.square() + sh.square()).rsqrt();
+    ch *= w;
+    sh *= w;
+
+    Lane c = ch.square() - sh.square();
+    Lane s = Scalar(2) * ch * sh;
+    for (int j = 0; j < 3; ++j) {
+        Lane bp = B[p][j], bq = B[q][j];
+        B[p][j] = c * bp + s * bq;
+        B[q][j] = c * bq - s * bp;
+        Lane up = U[j][p], uq = U[j][q];
+        U[j][p] = c * up + s * uq;
+        U[j][q] = c * uq - s * up;
+    }
+}
+
+// The full kernel on one batch; A, U, V are [row][col] arrays of lanes
+template <typename Lane>
+inline void svd3Kernel(const Lane A[3][3], Lane U[3][3], Lane sigma[3], Lane V[3][3], int sweeps) {
+    typedef typename Lane::Scalar Scalar;
+
+    // 1. S = A^T A (symmetric), Jacobi with quaternion-accumulated V
+    Lane S[3][3];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = i; j < 3; ++j) {
+            S[i][j] = A[0][i] * A[0][j] + A[1][i] * A[1][j] + A[2][i] * A[2][j];
+            S[j][i] = S[i][j];
+        }
+    }
+    Lane qw = Lane::Ones();
+    Lane qv[3] = {Lane::Zero(), Lane::Zero(), Lane::Zero()};
+    for (int sweep = 0; sweep < sweeps; ++sweep) {
+        svd3Jacobi(0, 1, 2, S, qw, qv);
+        svd3Jacobi(1, 2, 0, S, qw, qv);
+        svd3Jacobi(2, 0, 1, S, qw, qv);
+    }
+
+    Lane n = (qw.square() + qv[0].square() + qv[1].square() + qv[2].square()).rsqrt();
+    Lane w = qw * n, x = qv[0] * n, y = qv[1] * n, z = qv[2] * n;
+    V[0][0] = Scalar(1) - Scalar(2) * (y * y + z * z);
+    V[0][1] = Scalar(2) * (x * y - w * z);
+    V[0][2] = Scalar(2) * (x * z + w * y);
+    V[1][0] = Scalar(2) * (x * y + w * z);
+    V[1][1] = Scalar(1) - Scalar(2) * (x * x + z * z);
+    V[1][2] = Scalar(2) * (y * z - w * x);
+    V[2][0] = Scalar(2) * (x * z - w * y);
+    V[2][1] = Scalar(2) * (y * z + w * x);
+    V[2][2] = Scalar(1) - Scalar(2) * (x * x + y * y);
+
+    // 2. B = A V, columns sorted by decreasing norm
+    Lane B[3][3];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            B[i][j] = A[i][0] * V[0][j] + A[i][1] * V[1][j] + A[i][2] * V[2][j];
+        }
+    }
+    Lane rho[3];
+    for (int j = 0; j < 3; ++j) rho[j] = B[0][j].square() + B[1][j].square() + B[2][j].square();
+    // Masks are evaluated before the swap, which rewrites rho
+    svd3CondSwap((rho[0] < rho[1]).eval(), 0, 1, B, V, rho);
+    svd3CondSwap((rho[0] < rho[2]).eval(), 0, 2, B, V, rho);
+    svd3CondSwap((rho[1] < rho[2]).eval(), 1, 2, B, V, rho);
+
+    // 3. B = U R by Givens QR; R is diagonal up to the Jacobi residual
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) U[i][j] = Lane::Constant(i == j ? Scalar(1) : Scalar(0));
+    }
+    svd3QrGivens(0, 1, B, U);
+    svd3QrGivens(0, 2, B, U);
+    svd3QrGivens(1, 2, B, U);
+    for (int i = 0; i < 3; ++i) sigma[i] = B[i][i];
+}
+
+// Runs the kernel over n matrices in batches of Lanes; Sink(m, U, sigma, V)
+// receives the result of matrix m. A short last batch is padded with identity.
+template <typename Scalar, typename Sink>
+void svd3Batched(const Eigen::Matrix<Scalar, 3, 3>* A, size_t n, int sweeps, Sink&& sink) {
+    const int L = Svd3Lanes<Scalar>::value;
+    typedef Eigen::Array<Scalar, L, 1> Lane;
+    const size_t batches = (n + L - 1) / L;
+    parallelFor(batches, 64, [&](size_t b0, size_t b1) {
+        Lane a[3][3], u[3][3], s[3], v[3][3];
+        for (size_t b = b0; b < b1; ++b) {
+            const size_t base = b * L;
+            for (int l = 0; l < L; ++l) {
+                const size_t m = base + l;
+                for (int i = 0; i < 3; ++i) {
+                    for (int j = 0; j < 3; ++j) {
+                        a[i][j][l] = m < n ? A[m](i, j) : Scalar(i == j ? 1 : 0);
+                    }
+                }
+            }
+            svd3Kernel(a, u, s, v, sweeps);
+            for (int l = 0; l < L && base + l < n; ++l) {
+                Eigen::Matrix<Scalar, 3, 3> U, V;
+                Eigen::Matrix<Scalar, 3, 1> S(s[0][l], s[1][l], s[2][l]);
+                for (int i = 0; i < 3; ++i) {
+                    for (int j = 0; j < 3; ++j) {
+                        U(i, j) = u[i][j][l];
+                        V(i, j) = v[i][j][l];
+                    }
+                }
+                sink(base + l, U, S, V);
+            }
+        }
+    });
+}
+
+}  // namespace detail
+
+// A[m] = U[m] * diag(S[m]) * V[m]^T for m in [0, n), U and V rotations.
+// Any output pointer may be null if that factor is not needed.
+template <typename Scalar>
+void batchedSvd3(const Eigen::Matrix<Scalar, 3, 3>* A, size_t n,
+                 Eigen::Matrix<Scalar, 3, 3>* U, Eigen::Matrix<Scalar, 3, 1>* S,
+                 Eigen::Matrix<Scalar, 3, 3>* V, int sweeps = Svd3DefaultSweeps<Scalar>::value) {
+    detail::svd3Batched(A, n, sweeps, [&](size_t m, const Eigen::Matrix<Scalar, 3, 3>& u,
+                                          const Eigen::Matrix<Scalar, 3, 1>& s,
+                                          const Eigen::Matrix<Scalar, 3, 3>& v) {
+        if (U) U[m] = u;
+        if (S) S[m] = s;
+        if (V) V[m] = v;
+    });
+}
+
+// 2.2's closed-form alignment for many cross-covariances at once:
+// H = P_centered * Q_centered^T  ->  R = V U^T (always det(R) = +1)
+template <typename Scalar>
+void batchedProcrustesRotation(const Eigen::Matrix<Scalar, 3, 3>* H, size_t n,
+                               Eigen::Matrix<Scalar, 3, 3>* R,
+                               int sweeps = Svd3DefaultSweeps<Scalar>::value) {
+    detail::svd3Batched(H, n, sweeps, [&](size_t m, const Eigen::Matrix<Scalar, 3, 3>& u,
+                                          const Eigen::Matrix<Scalar, 3, 1>&,
+                                          const Eigen::Matrix<Scalar, 3, 3>& v) {
+        R[m] = v * u.transpose();
+    });
+}
+
+// Rotation SVD -> JacobiSVD conventions (all sigma >= 0, U may be a reflection)
+template <typename Scalar>
+void toStandardSvd(Eigen::Matrix<Scalar, 3, 3>& U, Eigen::Matrix<Scalar, 3, 1>& S) {
+    if (S(2) < Scalar(0)) {
+        S(2) = -S(2);
+        U.col(2) = -U.col(2);
+    }
+}
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_BATCHED_SVD3_H
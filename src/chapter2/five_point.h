@@ -0,0 +1,478 @@
+/**
+ * Five-point relative pose and RANSAC on essential matrices (see 2.15)
+ *
+ * Correspondences are normalized image coordinates (K^-1 applied, z = 1)
+ * and the model is x2^T E x1 = 0 with E = [t]_x R, x2 ~ R x1 + t (2.7).
+ *
+ * fivePoint() is the minimal solver of Stewenius, Engels and Nister
+ * ("Recent developments on direct relative orientation", 2006):
+ *   1. The five epipolar constraints leave E = x X + y Y + z Z + W with
+ *      X, Y, Z, W a basis of the 4-D null space (from a 9 x 5 QR).
+ *   2. det(E) = 0 and 2 E E^T E - tr(E E^T) E = 0 give 10 cubics in x, y, z
+ *      over 20 monomials. Eliminating the 10 cubic monomials leaves every
+ *      cubic as a combination of {x^2, xy, xz, y^2, yz, z^2, x, y, z, 1}.
+ *   3. Multiplication by x on that basis is a 10 x 10 action matrix whose
+ *      real eigenvectors are the basis monomials at the (up to 10) solutions.
+ *
+ * EssentialRansac draws minimal samples in rounds. The samples of a round
+ * are solved on all threads, and sample k always uses the same indices
+ * (counter-based draw from seed and k), so results do not depend on the
+ * thread count. Hypotheses are then scored with a preemptive schedule
+ * (Nister, "Preemptive RANSAC for live structure and motion estimation",
+ * 2003): all of them on the first block of correspondences, the better half
+ * on the next block, and so on, until one survives and is scored on the
+ * rest. Scores are truncated Sampson errors (MSAC), evaluated on
+ * structure-of-arrays buffers with Eigen array expressions so they
+ * vectorize. The number of samples adapts to the inlier ratio of the best
+ * model so far.
+ *
+ * The best E is decomposed into the four (R, t) candidates and the one that
+ * puts the most inliers in front of both cameras wins (cheirality).
+ */
+
+#ifndef EIGEN_TUTORIAL_FIVE_POINT_H
+#define EIGEN_TUTORIAL_FIVE_POINT_H
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <Eigen/Dense>
+
+#include "common/parallel.h"
+
+namespace eigen_tutorial {
+
+namespace detail {
+
+// Polynomial of degree <= 3 in x, y, z. Monomial order: the 10 cubics
+// x^3 x^2y x^2z xy^2 xyz xz^2 y^3 y^2z yz^2 z^3, then the quotient basis
+// x^2 xy xz y^2 yz z^2 x y z 1
+struct Poly3 {
+    double c[20];
+};
+
+struct MonomialTable {
+    int product[20][20];  // Index of the product monomial, -1 if degree > 3
+
+    MonomialTable() {
+        const int e[20][3] = {{3, 0, 0}, {2, 1, 0}, {2, 0, 1}, {1, 2, 0}, {1, 1, 1}, {1, 0, 2}, {0, 3, 0},
+                              {0, 2, 1}, {0, 1, 2}, {0, 0, 3}, {2, 0, 0}, {1, 1, 0}, {1, 0, 1}, {0, 2, 0},
+                              {0, 1, 1}, {0, 0, 2}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {0, 0, 0}};
+        for (int i = 0; i < 20; ++i) {
+            for (int j = 0; j < 20; ++j) {
+                product[i][j] = -1;
+                for (int m = 0; m < 20; ++m) {
+                    if (e[m][0] == e[i][0] + e[j][0] && e[m][1] == e[i][1] + e[j][1] &&
+                        e[m][2] == e[i][2] + e[j][2]) {
+                        product[i][j] = m;
+                    }
+                }
+            }
+        }
+    }
+};
+
+inline const MonomialTable& monomials() {
+    static const MonomialTable table;
+    return table;
+}
+
+inline Poly3 linearPoly(double x, double y, double z, double w) {
+    Poly3 p = {};
+    p.c[16] = x;
+    p.c[17] = y;
+    p.c[18] = z;
+    p.c[19] = w;
+    return p;
+}
+
+// a * b; the caller keeps the total degree <= 3
+inline Poly3 mul(const Poly3& a, const Poly3& b) {
+    const MonomialTable& t = monomials();
+    // Loop over the non-zero terms only (4 for E's entries, 10 for E E^T's)
+    int ia[20], ib[20], na = 0, nb = 0;
+    for (int i = 0; i < 20; ++i) {
+        if (a.c[i] != 0) ia[na++] = i;
+        if (b.c[i] != 0) ib[nb++] = i;
+    }
+    Poly3 r = {};
+    for (int i = 0; i < na; ++i) {
+        for (int j = 0; j < nb; ++j) r.c[t.product[ia[i]][ib[j]]] += a.c[ia[i]] * b.c[ib[j]];
+    }
+    return r;
+}
+
+// a + s * b
+inline Poly3 addScaled(const Poly3& a, double s, const Poly3& b) {
+    Poly3 r;
+    for (int i = 0; i < 20; ++i) r.c[i] = a.c[i] + s * b.c[i];
+    return r;
+}
+
+// SplitMix64: a stateless hash used to draw sample k reproducibly
+inline uint64_t splitMix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+}  // namespace detail
+
+// Essential matrices consistent with 5 correspondences (columns of x1, x2,
+// normalized image coordinates); writes up to 10 unit-norm E and returns
+// how many
+inline int fivePoint(const Eigen::Matrix<double, 2, 5>& x1, const Eigen::Matrix<double, 2, 5>& x2,
+                     Eigen::Matrix3d* E) {
+    // Rows of the 5 x 9 constraint matrix (E flattened row-major), as columns
+    Eigen::Matrix<double, 9, 5> Qt;
+    for (int i = 0; i < 5; ++i) {
+        const Eigen::Vector3d a(x1(0, i), x1(1, i), 1.0), b(x2(0, i), x2(1, i), 1.0);
+        for (int r = 0; r < 3; ++r) Qt.block<3, 1>(3 * r, i) = b(r) * a;
+    }
+    // Null space = the last 4 columns of the full Q factor of Qt
+    const Eigen::Matrix<double, 9, 9> Q = Eigen::HouseholderQR<Eigen::Matrix<double, 9, 5>>(Qt).householderQ();
+    const Eigen::Matrix<double, 9, 4> N = Q.rightCols<4>();
+
+    detail::Poly3 e[3][3];
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+            const int k = 3 * r + c;
+            e[r][c] = detail::linearPoly(N(k, 0), N(k, 1), N(k, 2), N(k, 3));
+        }
+    }
+
+    // Ten cubic constraints as rows of a 10 x 20 coefficient matrix
+    Eigen::Matrix<double, 10, 20> A;
+    const detail::Poly3 det =
+        addScaled(addScaled(mul(e[0][0], addScaled(mul(e[1][1], e[2][2]), -1, mul(e[1][2], e[2][1]))), -1,
+                            mul(e[0][1], addScaled(mul(e[1][0], e[2][2]), -1, mul(e[1][2], e[2][0])))),
+                  1, mul(e[0][2], addScaled(mul(e[1][0], e[2][1]), -1, mul(e[1][1], e[2][0]))));
+    for (int m = 0; m < 20; ++m) A(0, m) = det.c[m];
+
+    detail::Poly3 EEt[3][3];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = i; j < 3; ++j) {
+            EEt[i][j] = addScaled(addScaled(mul(e[i][0], e[j][0]), 1, mul(e[i][1], e[j][1])), 1,
+                                  mul(e[i][2], e[j][2]));
+            EEt[j][i] = EEt[i][j];
+        }
+    }
+    const detail::Poly3 trace = addScaled(addScaled(EEt[0][0], 1, EEt[1][1]), 1, EEt[2][2]);
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            detail::Poly3 p = addScaled(addScaled(mul(EEt[i][0], e[0][j]), 1, mul(EEt[i][1], e[1][j])), 1,
+                                        mul(EEt[i][2], e[2][j]));
+            p = addScaled(mul(trace, e[i][j]), -2, p);  // tr E - 2 EE^T E, same zeros
+            for (int m = 0; m < 20; ++m) A(1 + 3 * i + j, m) = p.c[m];
+        }
+    }
+
+    // Express the cubic monomials in the basis: cubic = -B * basis
+    Eigen::PartialPivLU<Eigen::Matrix<double, 10, 10>> lu(A.leftCols<10>());
+    const Eigen::Matrix<double, 10, 10> B = lu.solve(A.rightCols<10>());
+    if (!B.allFinite()) return 0;
+
+    // x * basis: x^3 .. xz^2 are cubics 0..5, the rest stay in the basis
+    Eigen::Matrix<double, 10, 10> M = Eigen::Matrix<double, 10, 10>::Zero();
+    M.topRows<6>() = -B.topRows<6>();
+    M(6, 0) = 1;  // x * x  = x^2
+    M(7, 1) = 1;  // x * y  = xy
+    M(8, 2) = 1;  // x * z  = xz
+    M(9, 6) = 1;  // x * 1  = x
+
+    Eigen::EigenSolver<Eigen::Matrix<double, 10, 10>> es(M);
+    if (es.info() != Eigen::Success) return 0;
+    int count = 0;
+    for (int k = 0; k < 10; ++k) {
+        const std::complex<double> lambda = es.eigenvalues()(k);
+        if (std::abs(lambda.imag()) > 1e-8 * (1 + std::abs(lambda.real()))) continue;
+        const Eigen::Matrix<double, 10, 1> v = es.eigenvectors().col(k).real();
+        if (std::abs(v(9)) < 1e-12) continue;
+        const Eigen::Vector4d xyz1(v(6) / v(9), v(7) / v(9), v(8) / v(9), 1.0);
+        const Eigen::Matrix<double, 9, 1> evec = N * xyz1;
+        E[count] = Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor>>(evec.data());
+        E[count] /= E[count].norm();
+        ++count;
+    }
+    return count;
+}
+
+// The four (R, t) factorizations of E = [t]_x R, |t| = 1
+inline void decomposeEssential(const Eigen::Matrix3d& E, Eigen::Matrix3d R[2], Eigen::Vector3d& t) {
+    Eigen::JacobiSVD<Eigen::Matrix3d> svd(E, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    Eigen::Matrix3d U = svd.matrixU(), V = svd.matrixV();
+    if (U.determinant() < 0) U.col(2) *= -1;
+    if (V.determinant() < 0) V.col(2) *= -1;
+    Eigen::Matrix3d W;
+    W << 0, -1, 0,
+         1,  0, 0,
+         0,  0, 1;
+    R[0] = U * W * V.transpose();
+    R[1] = U * W.transpose() * V.transpose();
+    t = U.col(2);
+}
+
+// Depths (d1, d2) with d2 x2 = R (d1 x1) + t in the least-squares sense
+inline Eigen::Vector2d triangulateDepths(const Eigen::Matrix3d& R, const Eigen::Vector3d& t,
+                                         const Eigen::Vector3d& x1, const Eigen::Vector3d& x2) {
+    Eigen::Matrix<double, 3, 2> A;
+    A << R * x1, -x2;
+    return (A.transpose() * A).ldlt().solve(-A.transpose() * t);
+}
+
+struct EssentialRansacOptions {
+    double threshold = 1e-3;        // Sampson distance in normalized units (~ pixels / focal)
+    double confidence = 0.999;      // Stop once a better model is this unlikely
+    int max_samples = 2000;         // Minimal samples drawn, at most
+    int samples_per_round = 32;     // Solved in parallel, then scored together
+    int preemptive_block = 100;     // Correspondences per preemption step; 0 = full scoring
+    int refinements = 2;            // Linear refits on the inliers of the best model
+    uint64_t seed = 0;
+};
+
+struct EssentialResult {
+    Eigen::Matrix3d E = Eigen::Matrix3d::Zero();
+    Eigen::Matrix3d R = Eigen::Matrix3d::Identity();
+    Eigen::Vector3d t = Eigen::Vector3d::Zero();  // Unit length
+    std::vector<uint8_t> inliers;                 // Per correspondence
+    size_t num_inliers = 0;
+    size_t num_in_front = 0;  // Inliers passing the cheirality check for (R, t)
+    int samples = 0;          // Minimal samples drawn
+    int hypotheses = 0;       // Essential matrices scored
+    bool success = false;
+};
+
+class EssentialRansac {
+public:
+    explicit EssentialRansac(const EssentialRansacOptions& options = EssentialRansacOptions())
+        : options_(options) {}
+
+    const EssentialRansacOptions& options() const { return options_; }
+    void setOptions(const EssentialRansacOptions& options) { options_ = options; }
+
+    // x1, x2: 2 x N normalized image coordinates of the same points in the
+    // first and second view
+    EssentialResult estimate(const Eigen::Matrix2Xd& x1, const Eigen::Matrix2Xd& x2) {
+        EssentialResult result;
+        const Eigen::Index n = x1.cols();
+        if (n < 5 || x2.cols() != n) return result;
+        loadShuffled(x1, x2);
+
+        const double thr2 = options_.threshold * options_.threshold;
+        const double log_fail = std::log(1 - options_.confidence);
+        double best_cost = std::numeric_limits<double>::infinity();
+        size_t best_inliers = 0;
+        double needed = options_.max_samples;
+        int drawn = 0;
+        while (drawn < std::min<double>(needed, options_.max_samples)) {
+            const int round = std::min(options_.samples_per_round, options_.max_samples - drawn);
+            solveRound(drawn, round, n);
+            drawn += round;
+            if (hypotheses_.empty()) continue;
+            result.hypotheses += static_cast<int>(hypotheses_.size());
+
+            const Eigen::Matrix3d& E = hypotheses_[preempt(n, thr2)];
+            const double cost = sampsonCost(E, 0, n, thr2);
+            if (cost < best_cost) {
+                best_cost = cost;
+                result.E = E;
+                best_inliers = countInliers(E, thr2);
+                // Samples needed so that an all-inlier one was drawn with
+                // the requested confidence
+                const double w = static_cast<double>(best_inliers) / n;
+                const double p_good = std::pow(w, 5);
+                needed = p_good >= 1 ? 0 : p_good <= 0 ? options_.max_samples : log_fail / std::log(1 - p_good);
+            }
+        }
+        result.samples = drawn;
+        if (best_inliers < 5) return result;
+
+        // The minimal sample fits 5 noisy points exactly; a least-squares
+        // fit to all inliers is kept when it lowers the cost
+        for (int i = 0; i < options_.refinements && best_inliers >= 8; ++i) {
+            const Eigen::Matrix3d E = refit(result.E, thr2);
+            const double cost = sampsonCost(E, 0, n, thr2);
+            if (!(cost < best_cost)) break;
+            best_cost = cost;
+            result.E = E;
+            best_inliers = countInliers(E, thr2);
+        }
+
+        // Inlier mask in the caller's order
+        result.inliers.assign(n, 0);
+        for (Eigen::Index k = 0; k < n; ++k) {
+            if (sampsonDistance(result.E, k) <= thr2) result.inliers[order_[k]] = 1;
+        }
+        result.num_inliers = best_inliers;
+        selectPose(result, x1, x2);
+        result.success = result.num_in_front > 0;
+        return result;
+    }
+
+    // Squared Sampson distance of correspondence k (shuffled order) to E
+    double sampsonDistance(const Eigen::Matrix3d& E, Eigen::Index k) const {
+        const Eigen::Vector3d a(u1_(k), v1_(k), 1), b(u2_(k), v2_(k), 1);
+        const Eigen::Vector3d Ea = E * a, Etb = E.transpose() * b;
+        const double r = b.dot(Ea);
+        return r * r / (Ea.head<2>().squaredNorm() + Etb.head<2>().squaredNorm());
+    }
+
+private:
+    static const size_t kMaxSolutions = 10;
+
+    // Copies the correspondences in a fixed random order, so that every
+    // block of the preemptive schedule is an unbiased subset
+    void loadShuffled(const Eigen::Matrix2Xd& x1, const Eigen::Matrix2Xd& x2) {
+        const Eigen::Index n = x1.cols();
+        order_.resize(n);
+        for (Eigen::Index k = 0; k < n; ++k) order_[k] = static_cast<int>(k);
+        for (Eigen::Index k = n - 1; k > 0; --k) {
+            const uint64_t r = detail::splitMix64(options_.seed ^ (0xA5A5A5A5ull + k));
+            std::swap(order_[k], order_[r % (k + 1)]);
+        }
+        u1_.resize(n);
+        v1_.resize(n);
+        u2_.resize(n);
+        v2_.resize(n);
+        for (Eigen::Index k = 0; k < n; ++k) {
+            u1_(k) = x1(0, order_[k]);
+            v1_(k) = x1(1, order_[k]);
+            u2_(k) = x2(0, order_[k]);
+            v2_(k) = x2(1, order_[k]);
+        }
+    }
+
+    // Solves samples first .. first + count - 1 into hypotheses_
+    void solveRound(int first, int count, Eigen::Index n) {
+        solutions_.resize(count * kMaxSolutions);
+        solution_count_.assign(count, 0);
+        parallelFor(count, 1, [&](size_t b, size_t e) {
+            for (size_t s = b; s < e; ++s) {
+                int idx[5];
+                uint64_t state = options_.seed * 0x9E3779B97F4A7C15ull + static_cast<uint64_t>(first + s);
+                for (int i = 0; i < 5; ++i) {
+                    bool repeated = true;
+                    while (repeated) {
+                        state = detail::splitMix64(state);
+                        idx[i] = static_cast<int>(state % static_cast<uint64_t>(n));
+                        repeated = std::find(idx, idx + i, idx[i]) != idx + i;
+                    }
+                }
+                Eigen::Matrix<double, 2, 5> a, c;
+                for (int i = 0; i < 5; ++i) {
+                    a.col(i) << u1_(idx[i]), v1_(idx[i]);
+                    c.col(i) << u2_(idx[i]), v2_(idx[i]);
+                }
+                solution_count_[s] = fivePoint(a, c, &solutions_[s * kMaxSolutions]);
+            }
+        });
+        hypotheses_.clear();
+        for (int s = 0; s < count; ++s) {
+            for (int k = 0; k < solution_count_[s]; ++k) hypotheses_.push_back(solutions_[s * kMaxSolutions + k]);
+        }
+    }
+
+    // Preemptive scoring of hypotheses_; returns the index of the survivor
+    size_t preempt(Eigen::Index n, double thr2) {
+        const size_t h = hypotheses_.size();
+        ranked_.resize(h);
+        for (size_t i = 0; i < h; ++i) ranked_[i] = std::make_pair(0.0, i);
+        if (options_.preemptive_block <= 0) {
+            for (size_t i = 0; i < h; ++i) ranked_[i].first = sampsonCost(hypotheses_[i], 0, n, thr2);
+            return std::min_element(ranked_.begin(), ranked_.end())->second;
+        }
+        size_t alive = h;
+        for (Eigen::Index b = 0; alive > 1 && b < n; b += options_.preemptive_block) {
+            const Eigen::Index len = std::min<Eigen::Index>(options_.preemptive_block, n - b);
+            for (size_t i = 0; i < alive; ++i) {
+                ranked_[i].first += sampsonCost(hypotheses_[ranked_[i].second], b, len, thr2);
+            }
+            const size_t keep = std::max<size_t>(1, alive / 2);
+            std::nth_element(ranked_.begin(), ranked_.begin() + (keep - 1), ranked_.begin() + alive);
+            alive = keep;
+        }
+        return std::min_element(ranked_.begin(), ranked_.begin() + alive)->second;
+    }
+
+    // Sum of min(d^2, thr2) over correspondences b .. b + len - 1 (MSAC)
+    double sampsonCost(const Eigen::Matrix3d& E, Eigen::Index b, Eigen::Index len, double thr2) const {
+        const auto u1 = u1_.segment(b, len);
+        const auto v1 = v1_.segment(b, len);
+        const auto u2 = u2_.segment(b, len);
+        const auto v2 = v2_.segment(b, len);
+        // E * [u1 v1 1] and E^T * [u2 v2 1], first two rows; one fused loop
+        const auto ex = E(0, 0) * u1 + E(0, 1) * v1 + E(0, 2);
+        const auto ey = E(1, 0) * u1 + E(1, 1) * v1 + E(1, 2);
+        const auto ez = E(2, 0) * u1 + E(2, 1) * v1 + E(2, 2);
+        const auto fx = E(0, 0) * u2 + E(1, 0) * v2 + E(2, 0);
+        const auto fy = E(0, 1) * u2 + E(1, 1) * v2 + E(2, 1);
+        const auto r = u2 * ex + v2 * ey + ez;
+        return (r.square() / (ex.square() + ey.square() + fx.square() + fy.square())).min(thr2).sum();
+    }
+
+    // Eight-point fit to the inliers of E, projected onto the essential
+    // manifold (singular values 1, 1, 0)
+    Eigen::Matrix3d refit(const Eigen::Matrix3d& E, double thr2) const {
+        Eigen::Matrix<double, 9, 9> ZtZ = Eigen::Matrix<double, 9, 9>::Zero();
+        for (Eigen::Index k = 0; k < u1_.size(); ++k) {
+            if (sampsonDistance(E, k) > thr2) continue;
+            const Eigen::Vector3d a(u1_(k), v1_(k), 1), b(u2_(k), v2_(k), 1);
+            Eigen::Matrix<double, 9, 1> z;
+            z << b(0) * a, b(1) * a, b(2) * a;
+            ZtZ.selfadjointView<Eigen::Lower>().rankUpdate(z);
+        }
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix<double, 9, 9>> es(ZtZ);
+        const Eigen::Matrix<double, 9, 1> e = es.eigenvectors().col(0);
+        const Eigen::Matrix3d F = Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor>>(e.data());
+        Eigen::JacobiSVD<Eigen::Matrix3d> svd(F, Eigen::ComputeFullU | Eigen::ComputeFullV);
+        const Eigen::Matrix3d P =
+            svd.matrixU() * Eigen::Vector3d(1, 1, 0).asDiagonal() * svd.matrixV().transpose();
+        return P / P.norm();
+    }
+
+    size_t countInliers(const Eigen::Matrix3d& E, double thr2) const {
+        size_t count = 0;
+        for (Eigen::Index k = 0; k < u1_.size(); ++k) count += sampsonDistance(E, k) <= thr2;
+        return count;
+    }
+
+    // Picks the (R, t) of result.E that puts the most inliers in front of
+    // both cameras
+    void selectPose(EssentialResult& result, const Eigen::Matrix2Xd& x1, const Eigen::Matrix2Xd& x2) const {
+        Eigen::Matrix3d R[2];
+        Eigen::Vector3d t;
+        decomposeEssential(result.E, R, t);
+        for (int c = 0; c < 4; ++c) {
+            const Eigen::Matrix3d& Rc = R[c / 2];
+            const Eigen::Vector3d tc = (c % 2) ? Eigen::Vector3d(-t) : t;
+            size_t in_front = 0;
+            for (Eigen::Index k = 0; k < x1.cols(); ++k) {
+                if (!result.inliers[k]) continue;
+                const Eigen::Vector2d d = triangulateDepths(Rc, tc, x1.col(k).homogeneous(), x2.col(k).homogeneous());
+                in_front += d(0) > 0 && d(1) > 0;
+            }
+            if (in_front > result.num_in_front) {
+                result.num_in_front = in_front;
+                result.R = Rc;
+                result.t = tc;
+            }
+        }
+    }
+
+    EssentialRansacOptions options_;
+    std::vector<int> order_;                // Shuffled position -> caller index
+    Eigen::ArrayXd u1_, v1_, u2_, v2_;      // Correspondences in shuffled order
+    std::vector<Eigen::Matrix3d, Eigen::aligned_allocator<Eigen::Matrix3d>> solutions_, hypotheses_;
+    std::vector<int> solution_count_;
+    std::vector<std::pair<double, size_t>> ranked_;  // (cost so far, hypothesis)
+};
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_FIVE_POINT_H
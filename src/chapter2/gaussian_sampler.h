@@ -0,0 +1,216 @@
+/**
+ * Multivariate Gaussian sampling on the Cholesky factor (see 2.14)
+ *
+ * x = mean + L * z with cov = L * L^T (2.4) and z ~ N(0, I). The covariance
+ * is factored once; samples are then produced in blocks:
+ *
+ *   1. Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as
+ *      1, 2, 3") turns a 128-bit counter into 4 random words. It has no
+ *      state, so any range of the stream can be generated independently.
+ *      The rounds run on arrays of counters, which the compiler vectorizes.
+ *   2. Box-Muller turns each pair of words into two normals, on Eigen
+ *      arrays (vectorized log / sqrt, and a polynomial sin / cos).
+ *   3. One matrix product applies L to a whole block of normals.
+ *
+ * Normal number g of stream s uses counter (g / 4, s) under key seed. So
+ * sample i of a stream has the same value whatever the thread count, the
+ * block size or the `first` offset it was requested at. Threads that need
+ * their own sequences use different stream ids.
+ *
+ * Uniforms carry 32 bits (24 for float), so |z| stays below about 6.7
+ * (5.8 for float): plenty for particle filters, not for tail studies.
+ */
+
+#ifndef EIGEN_TUTORIAL_GAUSSIAN_SAMPLER_H
+#define EIGEN_TUTORIAL_GAUSSIAN_SAMPLER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <Eigen/Dense>
+
+#include "common/parallel.h"
+
+namespace eigen_tutorial {
+
+// Below this many samples per thread, threads cost more than they save
+const size_t kGaussianMinChunk = 1 << 14;
+// Samples per triangular product (normals for a block stay in L1 / L2)
+const size_t kGaussianBlock = 1024;
+
+namespace detail {
+
+const int kPhiloxBatch = 64;  // Counters per batch (256 normals)
+
+// Philox4x32-10 on n counters in structure-of-arrays form, in place
+inline void philox4x32(uint32_t* c0, uint32_t* c1, uint32_t* c2, uint32_t* c3, int n, uint32_t k0,
+                       uint32_t k1) {
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < n; ++i) {
+            const uint64_t p0 = uint64_t(0xD2511F53u) * c0[i];
+            const uint64_t p1 = uint64_t(0xCD9E8D57u) * c2[i];
+            const uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1[i] ^ k0;
+            const uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3[i] ^ k1;
+            c0[i] = n0;
+            c1[i] = static_cast<uint32_t>(p1);
+            c2[i] = n2;
+            c3[i] = static_cast<uint32_t>(p0);
+        }
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+    }
+}
+
+// Word -> uniform in the open interval (0, 1)
+inline double toUniform(uint32_t x, double) { return (x + 0.5) * (1.0 / 4294967296.0); }
+inline float toUniform(uint32_t x, float) { return ((x >> 8) + 0.5f) * (1.0f / 16777216.0f); }
+
+// sin(2 pi u) and cos(2 pi u) for u in [0, 1]. Eigen's generic sin / cos do
+// a full range reduction per call (and are scalar for double on SSE2);
+// here u is reduced to the nearest quarter turn, leaving |phi| <= pi / 4
+// for two Taylor polynomials (error < 1e-16), and the quarter is applied
+// by swapping and negating. Pure multiply-add and select, so it vectorizes.
+template <typename ArrayType>
+void sinCos2Pi(const ArrayType& u, ArrayType& s, ArrayType& c) {
+    typedef typename ArrayType::Scalar Scalar;
+    // Round to nearest by adding and removing 1.5 * 2^mantissa: SSE2 has no
+    // packed round instruction, and Eigen's round() falls back to scalar code
+    const Scalar magic = Scalar(1.5) * std::ldexp(Scalar(1), std::numeric_limits<Scalar>::digits - 1);
+    const ArrayType q = (Scalar(4) * u + magic) - magic;
+    const ArrayType phi = Scalar(2 * M_PI) * (u - Scalar(0.25) * q);
+    const ArrayType p2 = phi * phi;
+    // sin: phi - phi^3/3! + ... - phi^15/15! + phi^17/17!
+    ArrayType sp = Scalar(1.0 / 355687428096000.0) * p2 - Scalar(1.0 / 1307674368000.0);
+    sp = sp * p2 + Scalar(1.0 / 6227020800.0);
+    sp = sp * p2 - Scalar(1.0 / 39916800.0);
+    sp = sp * p2 + Scalar(1.0 / 362880.0);
+    sp = sp * p2 - Scalar(1.0 / 5040.0);
+    sp = sp * p2 + Scalar(1.0 / 120.0);
+    sp = sp * p2 - Scalar(1.0 / 6.0);
+    sp = (sp * p2 + Scalar(1)) * phi;
+    // cos: 1 - phi^2/2! + ... + phi^16/16!
+    ArrayType cp = Scalar(1.0 / 20922789888000.0) * p2 - Scalar(1.0 / 87178291200.0);
+    cp = cp * p2 + Scalar(1.0 / 479001600.0);
+    cp = cp * p2 - Scalar(1.0 / 3628800.0);
+    cp = cp * p2 + Scalar(1.0 / 40320.0);
+    cp = cp * p2 - Scalar(1.0 / 720.0);
+    cp = cp * p2 + Scalar(1.0 / 24.0);
+    cp = cp * p2 - Scalar(0.5);
+    cp = cp * p2 + Scalar(1);
+    // Quarter q in {0, .., 4}: odd quarters swap sin and cos, quarters 1-2
+    // negate cos, quarters 2-3 negate sin
+    const ArrayType one = ArrayType::Ones();
+    const auto odd = ((q - Scalar(2)).abs() - Scalar(1)).abs() < Scalar(0.5);
+    const ArrayType sin_sign = ((q - Scalar(2.5)).abs() < Scalar(1)).select(-one, one);
+    const ArrayType cos_sign = ((q - Scalar(1.5)).abs() < Scalar(1)).select(-one, one);
+    s = sin_sign * odd.select(cp, sp);
+    c = cos_sign * odd.select(sp, cp);
+}
+
+}  // namespace detail
+
+// Normals first .. first + count - 1 of stream `stream` under key `seed`
+template <typename Scalar>
+void standardNormals(uint64_t seed, uint64_t stream, uint64_t first, size_t count, Scalar* out) {
+    typedef Eigen::Array<Scalar, 2 * detail::kPhiloxBatch, 1> Pairs;
+    const int kBatch = detail::kPhiloxBatch;
+    const uint64_t last = first + count;
+    const uint64_t c_end = (last + 3) / 4;
+    uint32_t c0[kBatch], c1[kBatch], c2[kBatch], c3[kBatch];
+    Pairs u1, u2;
+    for (uint64_t c = first / 4; c < c_end; c += kBatch) {
+        const int m = static_cast<int>(std::min<uint64_t>(kBatch, c_end - c));
+        for (int i = 0; i < m; ++i) {
+            c0[i] = static_cast<uint32_t>(c + i);
+            c1[i] = static_cast<uint32_t>((c + i) >> 32);
+            c2[i] = static_cast<uint32_t>(stream);
+            c3[i] = static_cast<uint32_t>(stream >> 32);
+        }
+        detail::philox4x32(c0, c1, c2, c3, m, static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32));
+        for (int i = 0; i < m; ++i) {
+            u1(2 * i) = detail::toUniform(c0[i], Scalar());
+            u2(2 * i) = detail::toUniform(c1[i], Scalar());
+            u1(2 * i + 1) = detail::toUniform(c2[i], Scalar());
+            u2(2 * i + 1) = detail::toUniform(c3[i], Scalar());
+        }
+        for (int i = 2 * m; i < 2 * kBatch; ++i) u1(i) = u2(i) = Scalar(0.5);
+
+        // Box-Muller on the whole batch
+        const Pairs r = (Scalar(-2) * u1.log()).sqrt();
+        Pairs sin_theta, cos_theta;
+        detail::sinCos2Pi(u2, sin_theta, cos_theta);
+
+        // Normal 4c + 2p + j is (r cos, r sin)[j] of pair p
+        Eigen::Array<Scalar, 2, 2 * detail::kPhiloxBatch> z;
+        z.row(0) = (r * cos_theta).transpose();
+        z.row(1) = (r * sin_theta).transpose();
+        const uint64_t g0 = std::max<uint64_t>(first, 4 * c);
+        const uint64_t g1 = std::min<uint64_t>(last, 4 * (c + m));
+        std::copy(z.data() + (g0 - 4 * c), z.data() + (g1 - 4 * c), out + (g0 - first));
+    }
+}
+
+template <typename Scalar, int Dim = Eigen::Dynamic>
+class GaussianSampler {
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef Eigen::Matrix<Scalar, Dim, 1> Vector;
+    typedef Eigen::Matrix<Scalar, Dim, Dim> Matrix;
+    typedef Eigen::Matrix<Scalar, Dim, Eigen::Dynamic> Samples;
+
+    GaussianSampler(const Vector& mean, const Matrix& cov, uint64_t seed = 0) : seed_(seed) {
+        setDistribution(mean, cov);
+    }
+
+    // Factors cov; false (and valid() == false) if it is not positive definite
+    bool setDistribution(const Vector& mean, const Matrix& cov) {
+        Eigen::LLT<Matrix> llt(cov);
+        valid_ = llt.info() == Eigen::Success;
+        mean_ = mean;
+        L_ = llt.matrixL();
+        return valid_;
+    }
+
+    bool valid() const { return valid_; }
+    Eigen::Index dim() const { return mean_.size(); }
+    const Vector& mean() const { return mean_; }
+    const Matrix& factor() const { return L_; }
+    uint64_t seed() const { return seed_; }
+    void setSeed(uint64_t seed) { seed_ = seed; }
+
+    // Samples first .. first + n - 1 of `stream` into the caller's dim x n
+    // column-major buffer
+    void sample(Scalar* out, size_t n, uint64_t stream = 0, uint64_t first = 0) const {
+        const Eigen::Index d = dim();
+        parallelFor(n, kGaussianMinChunk, [&](size_t b, size_t e) {
+            Samples z(d, static_cast<Eigen::Index>(kGaussianBlock));
+            for (size_t i = b; i < e; i += kGaussianBlock) {
+                const Eigen::Index m = static_cast<Eigen::Index>(std::min(kGaussianBlock, e - i));
+                standardNormals(seed_, stream, (first + i) * d, static_cast<size_t>(m * d), z.data());
+                Eigen::Map<Samples> x(out + i * d, d, m);
+                // L_ holds explicit zeros above the diagonal; for the small
+                // dimensions used here the plain product beats triangularView's
+                x.noalias() = L_ * z.leftCols(m);
+                x.colwise() += mean_;
+            }
+        }, kGaussianBlock);
+    }
+
+    void sample(Samples& out, size_t n, uint64_t stream = 0, uint64_t first = 0) const {
+        out.resize(dim(), static_cast<Eigen::Index>(n));
+        sample(out.data(), n, stream, first);
+    }
+
+private:
+    Vector mean_;
+    Matrix L_;
+    uint64_t seed_;
+    bool valid_ = false;
+};
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_GAUSSIAN_SAMPLER_H
@@ -0,0 +1,372 @@
+/**
+ * Multithreaded ICP around the 2.2 Procrustes core (see 2.11)
+ *
+ * 2.2 aligns two clouds whose correspondences are known. ICP alternates
+ *
+ *   1. correspondences: for every source point T p, the nearest target point
+ *      q within max_correspondence_distance (NeighborGrid below), rejected
+ *      when the normals disagree by more than max_normal_angle
+ *   2. update: the increment dT that best aligns the accepted pairs
+ *        point-to-point  closed form via ProcrustesAccumulator (2.10)
+ *        point-to-plane  min sum (n . (dT p' - q))^2, linearized in
+ *                        dT ~ (I + [w]x, v): 6x6 normal equations, LDLT
+ *   3. T <- dT T, until dT is below the rotation/translation tolerances
+ *
+ * Steps 1-2 are one fused pass over the source on all threads: each chunk
+ * searches and accumulates into its own partial sums, which are merged in
+ * chunk order. The source is visited in Z-order (sorted once per align()),
+ * so neighbouring queries hit the same, already cached, grid cells. The partial sums, the search grid and the target normals
+ * live in the Icp object, so iterations (and later align() calls on the
+ * same target) allocate nothing; only the worker threads are started anew.
+ *
+ * Point-to-plane needs target normals. setTarget() takes them, or estimates
+ * them from the neighbours within normal_radius (chapter2/sym_eigen3.h).
+ */
+
+#ifndef EIGEN_TUTORIAL_ICP_H
+#define EIGEN_TUTORIAL_ICP_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "chapter2/procrustes_accumulator.h"
+#include "chapter2/sym_eigen3.h"
+#include "common/parallel.h"
+#include "common/voxel_hash.h"
+
+namespace eigen_tutorial {
+
+// Exact nearest neighbour and radius search over a uniform grid: points are
+// bucketed into cubic cells and stored sorted by cell, so every cell is one
+// contiguous run. The cell edge adapts to the data (a handful of points per
+// occupied cell) and queries visit rings of cells outward from the query's
+// cell, stopping once no unvisited cell can hold anything closer.
+class NeighborGrid {
+public:
+    // max_radius bounds the cell size; queries may use any radius
+    void build(const Eigen::Matrix3Xd& points, double max_radius) {
+        const Eigen::Index n = points.cols();
+        keys_.resize(n);
+
+        // Occupancy at cell = max_radius tells the density; points on
+        // surfaces scale with the cell area, so shrink the edge to match.
+        // At most 4 rings per radius keeps misses (no neighbour) cheap.
+        cell_ = max_radius;
+        fillCells(points);
+        if (n > 0) {
+            double per_cell = static_cast<double>(n) / cells_.size();
+            if (per_cell > kTargetPerCell) {
+                cell_ = max_radius * std::max(0.25, std::sqrt(kTargetPerCell / per_cell));
+                fillCells(points);
+            }
+        }
+
+        // Prefix sums over the counts, then scatter points in cell order
+        uint32_t offset = 0;
+        cells_.forEach([&](const VoxelKey&, Cell& c) {
+            c.begin = offset;
+            offset += c.end;
+            c.end = c.begin;
+        });
+        sorted_.resize(3, n);
+        index_.resize(n);
+        for (Eigen::Index i = 0; i < n; ++i) {
+            Cell& c = *cells_.find(keys_[i]);
+            sorted_.col(c.end) = points.col(i);
+            index_[c.end] = static_cast<int>(i);
+            ++c.end;
+        }
+    }
+
+    double cellSize() const { return cell_; }
+
+    // Index of the nearest point within radius and its squared distance, or -1
+    int nearest(const Eigen::Vector3d& q, double radius, double& dist2) const {
+        const VoxelKey k = voxelOf(q, 1.0 / cell_);
+        const int rings = static_cast<int>(std::ceil(radius / cell_));
+        // Distance from q to the nearest face of its own cell
+        const Eigen::Vector3d lo = Eigen::Vector3d(k.x, k.y, k.z) * cell_;
+        const double margin = std::min((q - lo).minCoeff(), (lo.array() + cell_ - q.array()).minCoeff());
+        double best = radius * radius;
+        int best_j = -1;
+        for (int r = 0; r <= rings; ++r) {
+            forEachCellInRing(k, r, [&](const Cell& c) {
+                for (uint32_t j = c.begin; j < c.end; ++j) {
+                    double d2 = (sorted_.col(j) - q).squaredNorm();
+                    if (d2 < best) {
+                        best = d2;
+                        best_j = static_cast<int>(j);
+                    }
+                }
+            });
+            // Anything outside rings 0..r is at least this far away
+            double reach = r * cell_ + margin;
+            if (best <= reach * reach) break;
+        }
+        dist2 = best;
+        return best_j < 0 ? -1 : index_[best_j];
+    }
+
+    // fn(index) for every point within radius of q
+    template <typename F>
+    void forEachInRadius(const Eigen::Vector3d& q, double radius, F&& fn) const {
+        const VoxelKey k = voxelOf(q, 1.0 / cell_);
+        const int rings = static_cast<int>(std::ceil(radius / cell_));
+        const double r2 = radius * radius;
+        for (int r = 0; r <= rings; ++r) {
+            forEachCellInRing(k, r, [&](const Cell& c) {
+                for (uint32_t j = c.begin; j < c.end; ++j) {
+                    if ((sorted_.col(j) - q).squaredNorm() <= r2) fn(index_[j]);
+                }
+            });
+        }
+    }
+
+private:
+    struct Cell {
+        uint32_t begin = 0, end = 0;  // While counting, end holds the count
+    };
+
+    static constexpr double kTargetPerCell = 8.0;
+
+    void fillCells(const Eigen::Matrix3Xd& points) {
+        const double inv = 1.0 / cell_;
+        cells_.clear();
+        for (Eigen::Index i = 0; i < points.cols(); ++i) {
+            keys_[i] = voxelOf(points.col(i), inv);
+            ++cells_[keys_[i]].end;
+        }
+    }
+
+    // Occupied cells at Chebyshev distance exactly r from k
+    template <typename F>
+    void forEachCellInRing(const VoxelKey& k, int r, F&& fn) const {
+        for (int dx = -r; dx <= r; ++dx) {
+            for (int dy = -r; dy <= r; ++dy) {
+                const bool edge = std::abs(dx) == r || std::abs(dy) == r;
+                for (int dz = -r; dz <= r; dz += (edge ? 1 : 2 * std::max(r, 1))) {
+                    const Cell* c = cells_.find(VoxelKey{k.x + dx, k.y + dy, k.z + dz});
+                    if (c) fn(*c);
+                }
+            }
+        }
+    }
+
+    double cell_ = 1.0;
+    VoxelHashMap<Cell> cells_;
+    std::vector<VoxelKey> keys_;
+    Eigen::Matrix3Xd sorted_;
+    std::vector<int> index_;
+};
+
+enum class IcpMetric { kPointToPoint, kPointToPlane };
+
+struct IcpOptions {
+    IcpMetric metric = IcpMetric::kPointToPoint;
+    int max_iterations = 30;
+    double max_correspondence_distance = 1.0;
+    double normal_radius = 0.1;                 // Neighbourhood for estimated target normals
+    double max_normal_angle = M_PI;             // Radians; needs source and target normals
+    double rotation_tolerance = 1e-6;           // Converged when |dR| (radians) and
+    double translation_tolerance = 1e-6;        // |dt| both fall below these
+    size_t min_correspondences = 6;
+};
+
+struct IcpResult {
+    Eigen::Isometry3d transform = Eigen::Isometry3d::Identity();
+    int iterations = 0;
+    bool converged = false;
+    size_t correspondences = 0;  // Accepted in the last iteration
+    double rmse = 0;             // Of those pairs (point or plane distance), before the last update
+};
+
+class Icp {
+public:
+    typedef Eigen::Matrix<double, 6, 6> Matrix6d;
+    typedef Eigen::Matrix<double, 6, 1> Vector6d;
+
+    explicit Icp(const IcpOptions& options = IcpOptions()) : options_(options) {}
+
+    const IcpOptions& options() const { return options_; }
+
+    // The grid and estimated normals depend on the options: call setTarget()
+    // again after changing max_correspondence_distance or normal_radius
+    void setOptions(const IcpOptions& options) { options_ = options; }
+
+    // Copies the target and builds the search grid. Without normals,
+    // point-to-plane estimates them from the neighbours within the radius.
+    void setTarget(const Eigen::Matrix3Xd& points, const Eigen::Matrix3Xd* normals = nullptr) {
+        target_ = points;
+        grid_.build(target_, std::max(options_.max_correspondence_distance, options_.normal_radius));
+        if (normals) {
+            target_normals_ = *normals;
+        } else if (options_.metric == IcpMetric::kPointToPlane) {
+            estimateTargetNormals();
+        } else {
+            target_normals_.resize(3, 0);
+        }
+    }
+
+    const Eigen::Matrix3Xd& targetNormals() const { return target_normals_; }
+
+    // Aligns source to the target: target ~ result.transform * source
+    IcpResult align(const Eigen::Matrix3Xd& source,
+                    const Eigen::Isometry3d& initial = Eigen::Isometry3d::Identity(),
+                    const Eigen::Matrix3Xd* source_normals = nullptr) {
+        IcpResult result;
+        result.transform = initial;
+        const bool use_normals = source_normals && target_normals_.cols() == target_.cols() &&
+                                 options_.max_normal_angle < M_PI;
+        const double cos_max = std::cos(options_.max_normal_angle);
+        const size_t n = static_cast<size_t>(source.cols());
+        const int chunks = chunkCount(n, kIcpMinChunk);
+        if (partial_.size() < static_cast<size_t>(chunks)) partial_.resize(chunks);
+        sortSource(source, initial);
+
+        for (int iter = 0; iter < options_.max_iterations; ++iter) {
+            const Eigen::Isometry3d T = result.transform;
+            forChunks(n, chunks, [&](int c, size_t b, size_t e) {
+                Partial& acc = partial_[c];
+                acc.clear();
+                for (size_t k = b; k < e; ++k) {
+                    const int i = order_[k].second;
+                    const Eigen::Vector3d p = T * source.col(i);
+                    double d2;
+                    const int j = grid_.nearest(p, options_.max_correspondence_distance, d2);
+                    if (j < 0) continue;
+                    if (use_normals &&
+                        std::abs((T.linear() * source_normals->col(i)).dot(target_normals_.col(j))) < cos_max) {
+                        continue;
+                    }
+                    acc.add(options_.metric, p, target_.col(j), target_normals_, j, d2);
+                }
+            });
+            Partial total = partial_[0];
+            for (int c = 1; c < chunks; ++c) total.merge(partial_[c]);
+
+            result.iterations = iter + 1;
+            result.correspondences = total.count;
+            result.rmse = total.count > 0 ? std::sqrt(total.sq_error / total.count) : 0.0;
+            if (total.count < options_.min_correspondences) break;
+
+            Eigen::Isometry3d dT = Eigen::Isometry3d::Identity();
+            if (options_.metric == IcpMetric::kPointToPoint) {
+                Eigen::Matrix3d R;
+                Eigen::Vector3d t;
+                total.procrustes.solve(R, t);
+                dT.linear() = R;
+                dT.translation() = t;
+            } else {
+                Vector6d x = total.JtJ.selfadjointView<Eigen::Lower>().ldlt().solve(-total.Jtr);
+                Eigen::Vector3d w = x.head<3>();
+                double angle = w.norm();
+                if (angle > 0) dT.linear() = Eigen::AngleAxisd(angle, w / angle).toRotationMatrix();
+                dT.translation() = x.tail<3>();
+            }
+            result.transform = dT * result.transform;
+
+            double d_angle = Eigen::AngleAxisd(dT.linear()).angle();
+            if (d_angle < options_.rotation_tolerance &&
+                dT.translation().norm() < options_.translation_tolerance) {
+                result.converged = true;
+                break;
+            }
+        }
+        return result;
+    }
+
+private:
+    static const size_t kIcpMinChunk = 1 << 13;  // Source points per thread, at least
+
+    // One thread's sums for both metrics (only the selected one is filled)
+    struct Partial {
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        ProcrustesAccumulator procrustes;
+        Matrix6d JtJ;  // Lower triangle
+        Vector6d Jtr;
+        size_t count;
+        double sq_error;
+
+        Partial() { clear(); }
+
+        void clear() {
+            procrustes.clear();
+            JtJ.setZero();
+            Jtr.setZero();
+            count = 0;
+            sq_error = 0;
+        }
+
+        void add(IcpMetric metric, const Eigen::Vector3d& p, const Eigen::Vector3d& q,
+                 const Eigen::Matrix3Xd& normals, int j, double d2) {
+            ++count;
+            if (metric == IcpMetric::kPointToPoint) {
+                procrustes.add(p, q);
+                sq_error += d2;
+            } else {
+                // r = n . (p - q),  dr/d(w, v) = (p x n, n)
+                const Eigen::Vector3d nq = normals.col(j);
+                const double r = nq.dot(p - q);
+                Vector6d J;
+                J << p.cross(nq), nq;
+                JtJ.selfadjointView<Eigen::Lower>().rankUpdate(J);
+                Jtr += r * J;
+                sq_error += r * r;
+            }
+        }
+
+        void merge(const Partial& b) {
+            procrustes.merge(b.procrustes);
+            JtJ += b.JtJ;
+            Jtr += b.Jtr;
+            count += b.count;
+            sq_error += b.sq_error;
+        }
+    };
+
+    // Visit the source in Z-order of the grid cells: consecutive queries then
+    // touch the same cells, and each thread gets a compact region of space
+    void sortSource(const Eigen::Matrix3Xd& source, const Eigen::Isometry3d& T) {
+        const double inv = 1.0 / grid_.cellSize();
+        order_.resize(source.cols());
+        parallelFor(order_.size(), kIcpMinChunk, [&](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) {
+                order_[i].first = mortonCode(voxelOf(T * source.col(i), inv));
+                order_[i].second = static_cast<int>(i);
+            }
+        });
+        std::sort(order_.begin(), order_.end());
+    }
+
+    void estimateTargetNormals() {
+        const size_t n = static_cast<size_t>(target_.cols());
+        std::vector<CovarianceAccumulator3> acc(n);
+        parallelFor(n, kIcpMinChunk, [&](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) {
+                grid_.forEachInRadius(target_.col(i), options_.normal_radius, [&](int j) { acc[i].add(target_.col(j)); });
+            }
+        });
+        std::vector<Eigen::Vector3d> normals(n);
+        estimateNormals<double>(acc.data(), n, normals.data(), nullptr);
+        target_normals_.resize(3, target_.cols());
+        for (size_t i = 0; i < n; ++i) target_normals_.col(i) = normals[i];
+    }
+
+    IcpOptions options_;
+    Eigen::Matrix3Xd target_;
+    Eigen::Matrix3Xd target_normals_;
+    NeighborGrid grid_;
+    std::vector<Partial, Eigen::aligned_allocator<Partial>> partial_;
+    std::vector<std::pair<uint64_t, int>> order_;  // (Morton code, source index)
+};
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_ICP_H
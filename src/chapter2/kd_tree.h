@@ -0,0 +1,318 @@
+/**
+ * Flat-array KD-tree for k-NN and radius queries over 3 x N points (see 2.13)
+ *
+ * Layout: the tree is implicit and balanced. Every internal node splits its
+ * index range at the midpoint, so node i has children 2i+1 and 2i+2 and the
+ * range of a node follows from its parent's. Only the split value and axis
+ * are stored per node, and the points are copied in leaf order into one
+ * 3 x N matrix, so a leaf is a contiguous run of columns.
+ *
+ * build() accepts any 3 x N expression, including an Eigen::Map over a
+ * sensor buffer. It splits level by level on the axis of largest extent with
+ * std::nth_element; nodes of the same level are partitioned on different
+ * threads.
+ *
+ * Search is exact by default. With eps > 0 a subtree is skipped when it
+ * cannot hold a point closer than worst / (1 + eps), so every returned
+ * distance is within a factor (1 + eps) of the true k-th neighbour's.
+ *
+ * Batched queries run on all threads. k-NN results go straight into a k x M
+ * matrix; radius results vary in length, so each thread fills its own buffer
+ * and the buffers are concatenated in query order into NeighborLists.
+ */
+
+#ifndef EIGEN_TUTORIAL_KD_TREE_H
+#define EIGEN_TUTORIAL_KD_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <Eigen/Core>
+
+#include "common/parallel.h"
+
+namespace eigen_tutorial {
+
+// Below this many queries per thread, threads cost more than they save
+const size_t kKdTreeMinQueryChunk = 1024;
+
+// Variable-length neighbour lists in compressed form: the neighbours of
+// query m are indices[offsets[m] .. offsets[m + 1])
+template <typename Scalar>
+struct NeighborLists {
+    std::vector<size_t> offsets;
+    std::vector<int> indices;
+    std::vector<Scalar> dist2;
+
+    size_t count(size_t m) const { return offsets[m + 1] - offsets[m]; }
+
+    // Per-thread buffers, kept so that repeated batches do not allocate
+    std::vector<std::vector<int>> thread_indices;
+    std::vector<std::vector<Scalar>> thread_dist2;
+    std::vector<std::vector<size_t>> thread_counts;
+};
+
+template <typename Scalar>
+class KdTree3 {
+public:
+    typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+    typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> Matrix3X;
+    typedef Eigen::Matrix<int, Eigen::Dynamic, Eigen::Dynamic> IndexMatrix;
+    typedef Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> DistanceMatrix;
+
+    explicit KdTree3(int leaf_size = 16) : leaf_size_(std::max(1, leaf_size)) {}
+
+    template <typename Derived>
+    explicit KdTree3(const Eigen::MatrixBase<Derived>& points, int leaf_size = 16)
+        : leaf_size_(std::max(1, leaf_size)) {
+        build(points);
+    }
+
+    Eigen::Index size() const { return points_.cols(); }
+    int depth() const { return depth_; }
+
+    // Points in leaf order; column j is input point index(j)
+    const Matrix3X& points() const { return points_; }
+    int index(Eigen::Index j) const { return index_[j]; }
+
+    template <typename Derived>
+    void build(const Eigen::MatrixBase<Derived>& points) {
+        const size_t n = static_cast<size_t>(points.cols());
+        depth_ = 0;
+        while ((n >> depth_) > static_cast<size_t>(leaf_size_)) ++depth_;
+        const size_t internal = (size_t(1) << depth_) - 1;
+        split_.resize(internal);
+        axis_.resize(internal);
+
+        // Partition (point, index) records so the moves stay sequential
+        entries_.resize(n);
+        parallelFor(n, kKdTreeMinQueryChunk * 16, [&](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) {
+                entries_[i].p = points.col(i).template cast<Scalar>();
+                entries_[i].index = static_cast<int>(i);
+            }
+        });
+
+        // bounds[j] .. bounds[j + 1] is the range of node j of the current level
+        std::vector<size_t> bounds(2), next;
+        bounds[0] = 0;
+        bounds[1] = n;
+        for (int level = 0; level < depth_; ++level) {
+            const size_t nodes = size_t(1) << level;
+            parallelFor(nodes, 1, [&](size_t jb, size_t je) {
+                for (size_t j = jb; j < je; ++j) splitNode(nodes - 1 + j, bounds[j], bounds[j + 1]);
+            });
+            next.resize(2 * nodes + 1);
+            for (size_t j = 0; j < nodes; ++j) {
+                next[2 * j] = bounds[j];
+                next[2 * j + 1] = bounds[j] + (bounds[j + 1] - bounds[j]) / 2;
+            }
+            next[2 * nodes] = n;
+            bounds.swap(next);
+        }
+
+        points_.resize(3, static_cast<Eigen::Index>(n));
+        index_.resize(n);
+        parallelFor(n, kKdTreeMinQueryChunk * 16, [&](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) {
+                points_.col(i) = entries_[i].p;
+                index_[i] = entries_[i].index;
+            }
+        });
+        entries_.clear();
+        entries_.shrink_to_fit();
+    }
+
+    // Convenience for raw xyz buffers (x0 y0 z0 x1 ...)
+    void build(const Scalar* xyz, Eigen::Index n) { build(Eigen::Map<const Matrix3X>(xyz, 3, n)); }
+
+    // Up to k nearest neighbours of q closer than sqrt(max_dist2), ascending;
+    // returns how many were found. indices / dist2 need room for k entries.
+    int knn(const Vector3& q, int k, int* indices, Scalar* dist2, Scalar eps = 0,
+            Scalar max_dist2 = std::numeric_limits<Scalar>::infinity()) const {
+        if (k <= 0 || size() == 0) return 0;
+        int found = 0;
+        const Scalar prune = Scalar(1) / ((1 + eps) * (1 + eps));
+        Scalar worst = max_dist2;
+        search(q, [&]() { return worst * prune; },
+               [&](Eigen::Index j, Scalar d2) {
+                   if (d2 >= worst) return;
+                   // Insertion into the sorted list, dropping the k-th if full
+                   int pos = found < k ? found++ : k - 1;
+                   while (pos > 0 && dist2[pos - 1] > d2) {
+                       dist2[pos] = dist2[pos - 1];
+                       indices[pos] = indices[pos - 1];
+                       --pos;
+                   }
+                   dist2[pos] = d2;
+                   indices[pos] = static_cast<int>(j);
+                   if (found == k) worst = dist2[k - 1];
+               });
+        // Internal leaf-order positions to caller indices
+        for (int i = 0; i < found; ++i) indices[i] = index_[indices[i]];
+        return found;
+    }
+
+    // Index of the nearest point (-1 if none within sqrt(max_dist2))
+    int nearest(const Vector3& q, Scalar& dist2, Scalar eps = 0,
+                Scalar max_dist2 = std::numeric_limits<Scalar>::infinity()) const {
+        int i = -1;
+        dist2 = max_dist2;
+        knn(q, 1, &i, &dist2, eps, max_dist2);
+        return i;
+    }
+
+    // fn(index, dist2) for every point within radius of q, in no particular order
+    template <typename F>
+    void forEachInRadius(const Vector3& q, Scalar radius, F&& fn) const {
+        if (size() == 0) return;
+        const Scalar r2 = radius * radius;
+        search(q, [r2]() { return r2; }, [&](Eigen::Index j, Scalar d2) {
+            if (d2 <= r2) fn(index_[j], d2);
+        });
+    }
+
+    // k nearest neighbours of every column of queries: k x M, ascending,
+    // padded with index -1 / infinite distance where fewer than k exist
+    template <typename Derived>
+    void knnBatch(const Eigen::MatrixBase<Derived>& queries, int k, IndexMatrix& indices,
+                  DistanceMatrix& dist2, Scalar eps = 0,
+                  Scalar max_dist2 = std::numeric_limits<Scalar>::infinity()) const {
+        const size_t m = static_cast<size_t>(queries.cols());
+        indices.resize(k, static_cast<Eigen::Index>(m));
+        dist2.resize(k, static_cast<Eigen::Index>(m));
+        parallelFor(m, kKdTreeMinQueryChunk, [&](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) {
+                const Vector3 q = queries.col(i).template cast<Scalar>();
+                int* idx = indices.col(i).data();
+                Scalar* d2 = dist2.col(i).data();
+                for (int f = knn(q, k, idx, d2, eps, max_dist2); f < k; ++f) {
+                    idx[f] = -1;
+                    d2[f] = std::numeric_limits<Scalar>::infinity();
+                }
+            }
+        });
+    }
+
+    // All neighbours within radius of every column of queries
+    template <typename Derived>
+    void radiusBatch(const Eigen::MatrixBase<Derived>& queries, Scalar radius,
+                     NeighborLists<Scalar>& out) const {
+        const size_t m = static_cast<size_t>(queries.cols());
+        const int chunks = chunkCount(m, kKdTreeMinQueryChunk);
+        if (out.thread_indices.size() < static_cast<size_t>(chunks)) {
+            out.thread_indices.resize(chunks);
+            out.thread_dist2.resize(chunks);
+            out.thread_counts.resize(chunks);
+        }
+        forChunks(m, chunks, [&](int c, size_t b, size_t e) {
+            std::vector<int>& idx = out.thread_indices[c];
+            std::vector<Scalar>& d2 = out.thread_dist2[c];
+            std::vector<size_t>& counts = out.thread_counts[c];
+            idx.clear();
+            d2.clear();
+            counts.clear();
+            for (size_t i = b; i < e; ++i) {
+                const size_t before = idx.size();
+                forEachInRadius(queries.col(i).template cast<Scalar>(), radius, [&](int j, Scalar d) {
+                    idx.push_back(j);
+                    d2.push_back(d);
+                });
+                counts.push_back(idx.size() - before);
+            }
+        });
+
+        // Concatenate in chunk (= query) order
+        out.offsets.resize(m + 1);
+        out.offsets[0] = 0;
+        size_t q = 0, total = 0;
+        for (int c = 0; c < chunks; ++c) {
+            for (size_t count : out.thread_counts[c]) {
+                total += count;
+                out.offsets[++q] = total;
+            }
+        }
+        out.indices.resize(total);
+        out.dist2.resize(total);
+        forChunks(m, chunks, [&](int c, size_t b, size_t) {
+            std::copy(out.thread_indices[c].begin(), out.thread_indices[c].end(),
+                      out.indices.begin() + out.offsets[b]);
+            std::copy(out.thread_dist2[c].begin(), out.thread_dist2[c].end(),
+                      out.dist2.begin() + out.offsets[b]);
+        });
+    }
+
+private:
+    struct Entry {
+        Vector3 p;
+        int index;
+    };
+
+    // Depth-first descent, nearer child first. bound() is the current
+    // pruning distance; visit(j, d2) sees every point of every leaf reached.
+    template <typename Bound, typename Visit>
+    void search(const Vector3& q, Bound&& bound, Visit&& visit) const {
+        struct Pending {
+            size_t node, begin, end;
+            Scalar min_dist2;  // Lower bound on the distance to this subtree
+        };
+        Pending stack[64];
+        int top = 0;
+        stack[top++] = Pending{0, 0, static_cast<size_t>(size()), Scalar(0)};
+        const size_t internal = split_.size();
+        while (top > 0) {
+            Pending cur = stack[--top];
+            if (cur.min_dist2 > bound()) continue;
+            while (cur.node < internal) {
+                const size_t mid = cur.begin + (cur.end - cur.begin) / 2;
+                const Scalar diff = q(axis_[cur.node]) - split_[cur.node];
+                const Scalar far_dist2 = std::max(cur.min_dist2, diff * diff);
+                const size_t left = 2 * cur.node + 1;
+                if (diff < 0) {
+                    stack[top++] = Pending{left + 1, mid, cur.end, far_dist2};
+                    cur = Pending{left, cur.begin, mid, cur.min_dist2};
+                } else {
+                    stack[top++] = Pending{left, cur.begin, mid, far_dist2};
+                    cur = Pending{left + 1, mid, cur.end, cur.min_dist2};
+                }
+            }
+            for (size_t j = cur.begin; j < cur.end; ++j) {
+                visit(static_cast<Eigen::Index>(j), (points_.col(j) - q).squaredNorm());
+            }
+        }
+    }
+
+    // Splits entries_[b, e) at its midpoint along the axis of largest extent
+    void splitNode(size_t node, size_t b, size_t e) {
+        Vector3 lo = Vector3::Constant(std::numeric_limits<Scalar>::max());
+        Vector3 hi = -lo;
+        for (size_t i = b; i < e; ++i) {
+            lo = lo.cwiseMin(entries_[i].p);
+            hi = hi.cwiseMax(entries_[i].p);
+        }
+        int axis;
+        (hi - lo).maxCoeff(&axis);
+        const size_t mid = b + (e - b) / 2;
+        std::nth_element(entries_.begin() + b, entries_.begin() + mid, entries_.begin() + e,
+                         [axis](const Entry& x, const Entry& y) { return x.p(axis) < y.p(axis); });
+        split_[node] = entries_[mid].p(axis);
+        axis_[node] = static_cast<uint8_t>(axis);
+    }
+
+    int leaf_size_;
+    int depth_ = 0;
+    std::vector<Scalar> split_;
+    std::vector<uint8_t> axis_;
+    Matrix3X points_;
+    std::vector<int> index_;
+    std::vector<Entry, Eigen::aligned_allocator<Entry>> entries_;  // Build scratch
+};
+
+typedef KdTree3<double> KdTree3d;
+typedef KdTree3<float> KdTree3f;
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_KD_TREE_H
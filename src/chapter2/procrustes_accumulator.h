@@ -0,0 +1,175 @@
+/**
+ * Streaming single-pass Procrustes accumulator (see 2.10)
+ *
+ * 2.2 solves Q = R P + t by centering copies of both clouds and forming
+ * H = P_centered * Q_centered^T: three passes over the data and two 3xN
+ * temporaries per alignment. Everything the solution needs fits in 3x3 +
+ * 2x3 numbers, so the accumulator keeps only
+ *
+ *   W       total weight
+ *   mean_p  weighted centroid of the sources
+ *   mean_q  weighted centroid of the targets
+ *   H       sum w (p - mean_p)(q - mean_q)^T   (the 2.2 cross-covariance)
+ *
+ * updated Welford-style for each correspondence, or per block of a chunk
+ * (block sums relative to the block's first pair, then one merge). Two
+ * accumulators combine exactly, as with the variance in 1.9:
+ *
+ *   d_p = mean_p,b - mean_p,a,  d_q = mean_q,b - mean_q,a
+ *   H   = H_a + H_b + (W_a W_b / W) d_p d_q^T
+ *
+ * so threads accumulate their own ranges and merge at the end; memory is
+ * constant in N. solve() runs the single 3x3 SVD with 2.2's reflection fix.
+ */
+
+#ifndef EIGEN_TUTORIAL_PROCRUSTES_ACCUMULATOR_H
+#define EIGEN_TUTORIAL_PROCRUSTES_ACCUMULATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include <Eigen/Dense>
+
+#include "common/parallel.h"
+
+namespace eigen_tutorial {
+
+// Pairs per block of a chunk update (sums stay in registers / L1)
+const Eigen::Index kProcrustesBlock = 1024;
+
+// Below this many pairs per thread, threads cost more than they save
+const size_t kProcrustesMinChunk = 1 << 16;
+
+class ProcrustesAccumulator {
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    ProcrustesAccumulator() { clear(); }
+
+    void clear() {
+        weight_ = 0;
+        count_ = 0;
+        mean_p_.setZero();
+        mean_q_.setZero();
+        H_.setZero();
+    }
+
+    // One correspondence q ~ R p + t with weight w > 0
+    template <typename DerivedP, typename DerivedQ>
+    void add(const Eigen::MatrixBase<DerivedP>& p, const Eigen::MatrixBase<DerivedQ>& q, double w = 1.0) {
+        Eigen::Vector3d pd = p.template cast<double>();
+        Eigen::Vector3d qd = q.template cast<double>();
+        weight_ += w;
+        ++count_;
+        Eigen::Vector3d dp = pd - mean_p_;
+        double f = w / weight_;
+        mean_p_ += f * dp;
+        mean_q_ += f * (qd - mean_q_);
+        H_.noalias() += w * dp * (qd - mean_q_).transpose();
+    }
+
+    // Columns [begin, end) of P and Q (3 x N) as correspondences, unit weights
+    template <typename DerivedP, typename DerivedQ>
+    void addColumns(const Eigen::MatrixBase<DerivedP>& P, const Eigen::MatrixBase<DerivedQ>& Q,
+                    Eigen::Index begin, Eigen::Index end) {
+        for (Eigen::Index b = begin; b < end; b += kProcrustesBlock) {
+            Eigen::Index e = std::min(end, b + kProcrustesBlock);
+            // Sums relative to the block's first pair: no cancellation even
+            // when the clouds sit far from the origin
+            Eigen::Vector3d sp = P.col(b).template cast<double>();
+            Eigen::Vector3d sq = Q.col(b).template cast<double>();
+            Eigen::Vector3d sum_p = Eigen::Vector3d::Zero(), sum_q = Eigen::Vector3d::Zero();
+            Eigen::Matrix3d S = Eigen::Matrix3d::Zero();
+            for (Eigen::Index i = b; i < e; ++i) {
+                Eigen::Vector3d dp = P.col(i).template cast<double>() - sp;
+                Eigen::Vector3d dq = Q.col(i).template cast<double>() - sq;
+                sum_p += dp;
+                sum_q += dq;
+                S.noalias() += dp * dq.transpose();
+            }
+            const double n = static_cast<double>(e - b);
+            ProcrustesAccumulator block;
+            block.weight_ = n;
+            block.count_ = e - b;
+            block.mean_p_ = sp + sum_p / n;
+            block.mean_q_ = sq + sum_q / n;
+            block.H_ = S - sum_p * sum_q.transpose() / n;
+            merge(block);
+        }
+    }
+
+    template <typename DerivedP, typename DerivedQ>
+    void addColumns(const Eigen::MatrixBase<DerivedP>& P, const Eigen::MatrixBase<DerivedQ>& Q) {
+        addColumns(P, Q, 0, P.cols());
+    }
+
+    // Combine with an accumulator over other correspondences (any order)
+    void merge(const ProcrustesAccumulator& b) {
+        if (b.weight_ <= 0) return;
+        if (weight_ <= 0) {
+            *this = b;
+            return;
+        }
+        double w = weight_ + b.weight_;
+        Eigen::Vector3d dp = b.mean_p_ - mean_p_;
+        Eigen::Vector3d dq = b.mean_q_ - mean_q_;
+        H_ += b.H_ + (weight_ * b.weight_ / w) * dp * dq.transpose();
+        mean_p_ += (b.weight_ / w) * dp;
+        mean_q_ += (b.weight_ / w) * dq;
+        weight_ = w;
+        count_ += b.count_;
+    }
+
+    double weight() const { return weight_; }
+    Eigen::Index count() const { return count_; }
+    const Eigen::Vector3d& centroidP() const { return mean_p_; }
+    const Eigen::Vector3d& centroidQ() const { return mean_q_; }
+    const Eigen::Matrix3d& crossCovariance() const { return H_; }
+
+    // R, t minimizing sum w ||R p + t - q||^2. Returns false with fewer than 3 pairs.
+    bool solve(Eigen::Matrix3d& R, Eigen::Vector3d& t) const {
+        if (count_ < 3) {
+            R.setIdentity();
+            t.setZero();
+            return false;
+        }
+        Eigen::JacobiSVD<Eigen::Matrix3d> svd(H_, Eigen::ComputeFullU | Eigen::ComputeFullV);
+        R = svd.matrixV() * svd.matrixU().transpose();
+        // Handle reflection case (ensure det(R) = 1), as in 2.2
+        if (R.determinant() < 0) {
+            Eigen::Matrix3d V_corrected = svd.matrixV();
+            V_corrected.col(2) *= -1;
+            R = V_corrected * svd.matrixU().transpose();
+        }
+        t = mean_q_ - R * mean_p_;
+        return true;
+    }
+
+private:
+    double weight_;
+    Eigen::Index count_;
+    Eigen::Vector3d mean_p_;
+    Eigen::Vector3d mean_q_;
+    Eigen::Matrix3d H_;
+};
+
+// Accumulates the columns of P and Q (3 x N) on all threads. Each thread
+// covers one contiguous range; partial results are merged in range order,
+// so the result does not depend on thread timing.
+template <typename DerivedP, typename DerivedQ>
+ProcrustesAccumulator accumulateProcrustes(const Eigen::MatrixBase<DerivedP>& P,
+                                           const Eigen::MatrixBase<DerivedQ>& Q) {
+    const size_t n = static_cast<size_t>(P.cols());
+    int chunks = chunkCount(n, kProcrustesMinChunk);
+    std::vector<ProcrustesAccumulator, Eigen::aligned_allocator<ProcrustesAccumulator>> partial(chunks);
+    forChunks(n, chunks, [&](int c, size_t b, size_t e) {
+        partial[c].addColumns(P, Q, static_cast<Eigen::Index>(b), static_cast<Eigen::Index>(e));
+    }, static_cast<size_t>(kProcrustesBlock));
+    ProcrustesAccumulator total;
+    for (const ProcrustesAccumulator& a : partial) total.merge(a);
+    return total;
+}
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_PROCRUSTES_ACCUMULATOR_H
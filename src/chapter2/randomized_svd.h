@@ -0,0 +1,163 @@
+/**
+ * Randomized truncated SVD for large dense matrices (see 2.16)
+ *
+ * JacobiSVD / BDCSVD cost O(m n min(m, n)). When only the leading k singular
+ * triplets matter (rank, null space of the rest, truncated pseudo-inverse),
+ * the range finder of Halko, Martinsson and Tropp ("Finding structure with
+ * randomness", 2011) needs O(m n l) with l = k + oversampling:
+ *
+ *   1. Y = A * Omega with Omega an n x l Gaussian matrix (the counter-based
+ *      sampler of 2.14, so the result depends only on the seed)
+ *   2. q power iterations Y = A (A^T Q), re-orthonormalized with QR each
+ *      pass, sharpen a slowly decaying spectrum
+ *   3. Q = qr(Y), B = Q^T A (l x n), small SVD of B = U_B S V^T, U = Q U_B
+ *
+ * The products with A dominate, and they are split across threads: A * X
+ * by row blocks of A, A^T * X by column blocks. Each block is an ordinary
+ * Eigen GEMM.
+ *
+ * Singular values beyond the first l are not seen. rank() therefore reports
+ * when all l values pass the tolerance, and the true rank may be larger:
+ * increase the target rank and compute again.
+ */
+
+#ifndef EIGEN_TUTORIAL_RANDOMIZED_SVD_H
+#define EIGEN_TUTORIAL_RANDOMIZED_SVD_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <Eigen/Dense>
+
+#include "chapter2/gaussian_sampler.h"
+#include "common/parallel.h"
+
+namespace eigen_tutorial {
+
+// Below this many rows (or columns) of A per thread, threads cost more than they save
+const size_t kRandomizedSvdMinChunk = 256;
+
+struct RandomizedSvdOptions {
+    int rank = 10;              // Target rank k
+    int oversampling = 10;      // Extra sample columns p (l = k + p)
+    int power_iterations = 2;   // q; 0 is fine for fast-decaying spectra
+    uint64_t seed = 0;
+};
+
+namespace detail {
+
+// out = A * X, by row blocks of A
+template <typename Derived>
+void parallelProduct(const Eigen::MatrixBase<Derived>& A, const Eigen::MatrixXd& X, Eigen::MatrixXd& out) {
+    out.resize(A.rows(), X.cols());
+    parallelFor(static_cast<size_t>(A.rows()), kRandomizedSvdMinChunk, [&](size_t b, size_t e) {
+        const Eigen::Index len = static_cast<Eigen::Index>(e - b);
+        out.middleRows(b, len).noalias() = A.middleRows(b, len) * X;
+    });
+}
+
+// out = A^T * X, by column blocks of A
+template <typename Derived>
+void parallelTransposeProduct(const Eigen::MatrixBase<Derived>& A, const Eigen::MatrixXd& X,
+                              Eigen::MatrixXd& out) {
+    out.resize(A.cols(), X.cols());
+    parallelFor(static_cast<size_t>(A.cols()), kRandomizedSvdMinChunk, [&](size_t b, size_t e) {
+        const Eigen::Index len = static_cast<Eigen::Index>(e - b);
+        out.middleRows(b, len).noalias() = A.middleCols(b, len).transpose() * X;
+    });
+}
+
+// Y <- orthonormal basis of range(Y) (thin Q of Householder QR)
+inline void orthonormalize(Eigen::MatrixXd& Y) {
+    Eigen::HouseholderQR<Eigen::MatrixXd> qr(Y);
+    Y = qr.householderQ() * Eigen::MatrixXd::Identity(Y.rows(), Y.cols());
+}
+
+}  // namespace detail
+
+class RandomizedSvd {
+public:
+    RandomizedSvd() {}
+
+    template <typename Derived>
+    explicit RandomizedSvd(const Eigen::MatrixBase<Derived>& A,
+                           const RandomizedSvdOptions& options = RandomizedSvdOptions()) {
+        compute(A, options);
+    }
+
+    template <typename Derived>
+    RandomizedSvd& compute(const Eigen::MatrixBase<Derived>& A,
+                           const RandomizedSvdOptions& options = RandomizedSvdOptions()) {
+        const Eigen::Index m = A.rows(), n = A.cols();
+        const Eigen::Index l = std::min<Eigen::Index>(options.rank + options.oversampling, std::min(m, n));
+        const Eigen::Index k = std::min<Eigen::Index>(options.rank, l);
+
+        // Gaussian test matrix, filled in parallel from the counter-based stream
+        Eigen::MatrixXd omega(n, l);
+        const size_t total = static_cast<size_t>(n * l);
+        parallelFor(total, kGaussianMinChunk, [&](size_t b, size_t e) {
+            standardNormals(options.seed, 0, b, e - b, omega.data() + b);
+        });
+
+        Eigen::MatrixXd Y, Z;
+        detail::parallelProduct(A, omega, Y);
+        for (int i = 0; i < options.power_iterations; ++i) {
+            detail::orthonormalize(Y);
+            detail::parallelTransposeProduct(A, Y, Z);
+            detail::orthonormalize(Z);
+            detail::parallelProduct(A, Z, Y);
+        }
+        detail::orthonormalize(Y);
+
+        // B^T = A^T Q (n x l); the SVD of the small factor gives A's
+        Eigen::MatrixXd Bt;
+        detail::parallelTransposeProduct(A, Y, Bt);
+        Eigen::BDCSVD<Eigen::MatrixXd> svd(Bt, Eigen::ComputeThinU | Eigen::ComputeThinV);
+        sampled_ = svd.singularValues();
+        singular_values_ = sampled_.head(k);
+        V_ = svd.matrixU().leftCols(k);
+        U_ = Y * svd.matrixV().leftCols(k);
+        return *this;
+    }
+
+    const Eigen::MatrixXd& matrixU() const { return U_; }               // m x k
+    const Eigen::VectorXd& singularValues() const { return singular_values_; }
+    const Eigen::MatrixXd& matrixV() const { return V_; }               // n x k
+
+    // Number of singular values above tolerance * sigma_0, among the k + p
+    // that were sampled; saturated = all of them passed (rank may be higher)
+    Eigen::Index rank(double tolerance, bool* saturated = nullptr) const {
+        if (sampled_.size() == 0 || sampled_(0) == 0) {
+            if (saturated) *saturated = false;
+            return 0;
+        }
+        const Eigen::Index r = (sampled_.array() > tolerance * sampled_(0)).count();
+        if (saturated) *saturated = r == sampled_.size();
+        return r;
+    }
+
+    // Truncated pseudo-inverse applied to b: V S^-1 U^T b over the singular
+    // values above tolerance * sigma_0 (never forms the n x m matrix)
+    template <typename Derived>
+    Eigen::MatrixXd solve(const Eigen::MatrixBase<Derived>& b, double tolerance = 1e-10) const {
+        const Eigen::Index r = std::min(rank(tolerance), singular_values_.size());
+        return V_.leftCols(r) *
+               (singular_values_.head(r).cwiseInverse().asDiagonal() * (U_.leftCols(r).transpose() * b));
+    }
+
+    // The n x m truncated pseudo-inverse itself, for small problems
+    Eigen::MatrixXd pseudoInverse(double tolerance = 1e-10) const {
+        const Eigen::Index r = std::min(rank(tolerance), singular_values_.size());
+        return V_.leftCols(r) * singular_values_.head(r).cwiseInverse().asDiagonal() *
+               U_.leftCols(r).transpose();
+    }
+
+private:
+    Eigen::MatrixXd U_, V_;
+    Eigen::VectorXd singular_values_;  // First k
+    Eigen::VectorXd sampled_;          // All l, for rank()
+};
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_RANDOMIZED_SVD_H
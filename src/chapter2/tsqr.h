@@ -0,0 +1,174 @@
+/**
+ * Tall-skinny QR (TSQR) and least squares without the tall matrix (see 2.17)
+ *
+ * For A of m x n with m >> n only R (n x n) is needed for least squares:
+ * with [A | b] = Q R, x solves R11 x = r12 and |r22| is the residual norm.
+ * R can be built from row blocks, because
+ *
+ *   R([A1; A2]) = R([R(A1); A2])     (up to row signs)
+ *
+ * so each block only meets an n x n triangle, never the rows before it.
+ *
+ *   TsqrAccumulator   streams rows (any block size) into R, staging them in
+ *                     a (n + kTsqrBlock) x n buffer factored in place
+ *   tsqrR()           splits A's rows across threads, one accumulator per
+ *                     thread, then merges the R factors pairwise in a tree
+ *   tsqrLeastSquares  the same on [A | b] without copying it
+ *
+ * Only R and one block of rows are ever in memory per thread, so rows can
+ * come from disk or a sensor log (addRows()). Unlike the normal equations,
+ * this never squares the condition number of A.
+ */
+
+#ifndef EIGEN_TUTORIAL_TSQR_H
+#define EIGEN_TUTORIAL_TSQR_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include <Eigen/Dense>
+
+#include "common/parallel.h"
+
+namespace eigen_tutorial {
+
+// Rows staged per factorization: big enough for blocked Householder, small
+// enough that the buffer stays in L2 for n ~ 20
+const Eigen::Index kTsqrBlock = 512;
+// Below this many rows per thread, threads cost more than they save
+const size_t kTsqrMinChunk = 1 << 14;
+
+class TsqrAccumulator {
+public:
+    explicit TsqrAccumulator(Eigen::Index cols = 0) { reset(cols); }
+
+    void reset(Eigen::Index cols) {
+        cols_ = cols;
+        buffer_.setZero(cols + kTsqrBlock, cols);
+        staged_ = 0;
+        rows_ = 0;
+    }
+
+    Eigen::Index cols() const { return cols_; }
+    Eigen::Index rowsAdded() const { return rows_; }
+
+    // Appends the rows of block (k x cols)
+    template <typename Derived>
+    void addRows(const Eigen::MatrixBase<Derived>& block) {
+        for (Eigen::Index b = 0; b < block.rows();) {
+            const Eigen::Index len = std::min(kTsqrBlock - staged_, block.rows() - b);
+            buffer_.middleRows(cols_ + staged_, len) = block.middleRows(b, len);
+            stage(len);
+            b += len;
+        }
+    }
+
+    // Appends [A | y] row by row (k x (cols - 1) and k x 1), for least squares
+    template <typename DerivedA, typename DerivedB>
+    void addRows(const Eigen::MatrixBase<DerivedA>& A, const Eigen::MatrixBase<DerivedB>& y) {
+        const Eigen::Index n = cols_ - 1;
+        for (Eigen::Index b = 0; b < A.rows();) {
+            const Eigen::Index len = std::min(kTsqrBlock - staged_, A.rows() - b);
+            buffer_.block(cols_ + staged_, 0, len, n) = A.middleRows(b, len);
+            buffer_.block(cols_ + staged_, n, len, 1) = y.middleRows(b, len);
+            stage(len);
+            b += len;
+        }
+    }
+
+    // Folds in another accumulator's rows
+    void merge(const TsqrAccumulator& other) {
+        const Eigen::Index rows = rows_ + other.rows_;
+        addRows(other.matrixR());
+        rows_ = rows;
+    }
+
+    // Upper-triangular R of all rows so far (cols x cols)
+    Eigen::MatrixXd matrixR() const {
+        if (staged_ == 0) return buffer_.topRows(cols_);
+        Eigen::MatrixXd stack = buffer_.topRows(cols_ + staged_);
+        Eigen::HouseholderQR<Eigen::Ref<Eigen::MatrixXd>> qr(stack);
+        return qr.matrixQR().topRows(cols_).triangularView<Eigen::Upper>();
+    }
+
+    // Least squares from an accumulator fed [A | y]: x and the residual norm
+    Eigen::VectorXd solve(double* residual_norm = nullptr) const {
+        return solveFromR(matrixR(), residual_norm);
+    }
+
+    // R of [A | y] -> x = argmin |A x - y|
+    static Eigen::VectorXd solveFromR(const Eigen::MatrixXd& R, double* residual_norm = nullptr) {
+        const Eigen::Index n = R.cols() - 1;
+        if (residual_norm) *residual_norm = std::abs(R(n, n));
+        return R.topLeftCorner(n, n).triangularView<Eigen::Upper>().solve(R.col(n).head(n));
+    }
+
+private:
+    // Counts len newly written rows; factors the buffer when it is full
+    void stage(Eigen::Index len) {
+        staged_ += len;
+        rows_ += len;
+        if (staged_ == kTsqrBlock) flush();
+    }
+
+    // In-place QR of [R; staged rows]: R ends up in the top rows
+    void flush() {
+        Eigen::Ref<Eigen::MatrixXd> stack = buffer_.topRows(cols_ + staged_);
+        Eigen::HouseholderQR<Eigen::Ref<Eigen::MatrixXd>> qr(stack);
+        buffer_.topRows(cols_).triangularView<Eigen::StrictlyLower>().setZero();
+        staged_ = 0;
+    }
+
+    Eigen::Index cols_ = 0;
+    Eigen::MatrixXd buffer_;  // Top cols_ rows: R; then up to kTsqrBlock staged rows
+    Eigen::Index staged_ = 0;
+    Eigen::Index rows_ = 0;
+};
+
+namespace detail {
+
+// Runs add(acc, begin, end) over row chunks of m on all threads, then merges
+// the per-thread factors pairwise: (0,1) (2,3) ..., then (0,2) ..., in parallel
+template <typename Add>
+Eigen::MatrixXd tsqrTree(size_t m, Eigen::Index cols, Add&& add) {
+    const int chunks = chunkCount(m, kTsqrMinChunk);
+    std::vector<TsqrAccumulator> parts(chunks, TsqrAccumulator(cols));
+    forChunks(m, chunks, [&](int c, size_t b, size_t e) { add(parts[c], b, e); });
+    for (int step = 1; step < chunks; step *= 2) {
+        const int pairs = (chunks + 2 * step - 1) / (2 * step);
+        parallelFor(pairs, 1, [&](size_t pb, size_t pe) {
+            for (size_t p = pb; p < pe; ++p) {
+                const size_t left = 2 * step * p, right = left + step;
+                if (right < static_cast<size_t>(chunks)) parts[left].merge(parts[right]);
+            }
+        });
+    }
+    return parts[0].matrixR();
+}
+
+}  // namespace detail
+
+// R of A (cols x cols, upper triangular), rows factored on all threads
+template <typename Derived>
+Eigen::MatrixXd tsqrR(const Eigen::MatrixBase<Derived>& A) {
+    return detail::tsqrTree(static_cast<size_t>(A.rows()), A.cols(),
+                            [&](TsqrAccumulator& acc, size_t b, size_t e) {
+                                acc.addRows(A.middleRows(b, e - b));
+                            });
+}
+
+// argmin |A x - y| through the R factor of [A | y]
+template <typename DerivedA, typename DerivedB>
+Eigen::VectorXd tsqrLeastSquares(const Eigen::MatrixBase<DerivedA>& A, const Eigen::MatrixBase<DerivedB>& y,
+                                 double* residual_norm = nullptr) {
+    const Eigen::MatrixXd R = detail::tsqrTree(static_cast<size_t>(A.rows()), A.cols() + 1,
+                                               [&](TsqrAccumulator& acc, size_t b, size_t e) {
+                                                   acc.addRows(A.middleRows(b, e - b), y.middleRows(b, e - b));
+                                               });
+    return TsqrAccumulator::solveFromR(R, residual_norm);
+}
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_TSQR_H
@@ -0,0 +1,187 @@
+/**
+ * Voxel-grid downsampling and an incremental voxel map (see 2.12)
+ *
+ * Raw scans are far denser than the SVD / ICP / normal-estimation kernels
+ * need. A voxel grid keeps one point per occupied cube of edge `voxel`:
+ *
+ *   kCentroid     the mean of the points in the voxel (smooths noise)
+ *   kFirstPoint   the first point that fell into the voxel (an actual
+ *                 measurement rather than an average)
+ *
+ * Voxels live in the open-addressing VoxelHashMap (common/voxel_hash.h).
+ * Insertion is parallel: every thread bins a contiguous range of the input
+ * into its own map, and the per-thread maps are merged in range order, so
+ * "first" really is the first point in input order and sums are
+ * deterministic. Output is ordered by each voxel's first point.
+ *
+ * VoxelMap keeps the voxels between calls: insert() each new scan (with its
+ * pose) and read the downsampled map with points(). Its per-thread maps and
+ * the map itself keep their capacity, so steady-state insertion does not
+ * allocate.
+ */
+
+#ifndef EIGEN_TUTORIAL_VOXEL_DOWNSAMPLE_H
+#define EIGEN_TUTORIAL_VOXEL_DOWNSAMPLE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "common/parallel.h"
+#include "common/voxel_hash.h"
+
+namespace eigen_tutorial {
+
+enum class VoxelReduction { kCentroid, kFirstPoint };
+
+// Below this many points per thread, threads cost more than they save
+const size_t kVoxelMinChunk = 1 << 16;
+
+struct VoxelCell {
+    Eigen::Vector3d sum = Eigen::Vector3d::Zero();    // kCentroid
+    Eigen::Vector3d first = Eigen::Vector3d::Zero();  // kFirstPoint
+    uint64_t order = 0;                               // Sequence number of the first point
+    uint32_t count = 0;
+
+    Eigen::Vector3d point(VoxelReduction mode) const {
+        return mode == VoxelReduction::kCentroid ? Eigen::Vector3d(sum / count) : first;
+    }
+
+    // Fold in a cell of points that came later
+    void merge(const VoxelCell& b) {
+        if (count == 0) {
+            *this = b;
+            return;
+        }
+        sum += b.sum;
+        count += b.count;
+    }
+};
+
+typedef VoxelHashMap<VoxelCell> VoxelCellMap;
+
+namespace detail {
+
+// Bins T * points.col(i), i in [b, e), into map; sequence numbers start at base
+template <typename Derived>
+void binPoints(const Eigen::MatrixBase<Derived>& points, const Eigen::Isometry3d& T, bool identity,
+               double inv_voxel, size_t b, size_t e, uint64_t base, VoxelCellMap& map) {
+    for (size_t i = b; i < e; ++i) {
+        Eigen::Vector3d p = points.col(i).template cast<double>();
+        if (!identity) p = T * p;
+        std::pair<VoxelCell*, bool> slot = map.insert(voxelOf(p, inv_voxel));
+        VoxelCell& c = *slot.first;
+        if (slot.second) {
+            c.first = p;
+            c.order = base + i;
+        }
+        c.sum += p;
+        ++c.count;
+    }
+}
+
+// Bins all points on all threads into locals[c], then merges them into map
+// in chunk order
+template <typename Derived>
+void binParallel(const Eigen::MatrixBase<Derived>& points, const Eigen::Isometry3d& T, double voxel,
+                 uint64_t base, std::vector<VoxelCellMap>& locals, VoxelCellMap& map) {
+    const size_t n = static_cast<size_t>(points.cols());
+    const double inv_voxel = 1.0 / voxel;
+    const bool identity = T.matrix().isIdentity(0);
+    const int chunks = chunkCount(n, kVoxelMinChunk);
+    if (chunks <= 1) {
+        // One thread: no point in a private map
+        binPoints(points, T, identity, inv_voxel, 0, n, base, map);
+        return;
+    }
+    if (locals.size() < static_cast<size_t>(chunks)) locals.resize(chunks);
+    forChunks(n, chunks, [&](int c, size_t b, size_t e) {
+        locals[c].clear();
+        binPoints(points, T, identity, inv_voxel, b, e, base, locals[c]);
+    });
+    for (int c = 0; c < chunks; ++c) {
+        locals[c].forEach([&](const VoxelKey& key, const VoxelCell& cell) {
+            map[key].merge(cell);
+        });
+    }
+}
+
+// Voxel representatives ordered by first appearance
+inline void extractVoxels(const VoxelCellMap& map, VoxelReduction mode,
+                          std::vector<std::pair<uint64_t, const VoxelCell*>>& scratch,
+                          Eigen::Matrix3Xd& out) {
+    scratch.clear();
+    map.forEach([&](const VoxelKey&, const VoxelCell& c) { scratch.emplace_back(c.order, &c); });
+    std::sort(scratch.begin(), scratch.end(),
+              [](const std::pair<uint64_t, const VoxelCell*>& a,
+                 const std::pair<uint64_t, const VoxelCell*>& b) { return a.first < b.first; });
+    out.resize(3, static_cast<Eigen::Index>(scratch.size()));
+    for (size_t i = 0; i < scratch.size(); ++i) out.col(i) = scratch[i].second->point(mode);
+}
+
+}  // namespace detail
+
+// One point per occupied voxel of edge `voxel` (3 x N in, 3 x M out, M <= N)
+template <typename Derived>
+Eigen::Matrix3Xd voxelDownsample(const Eigen::MatrixBase<Derived>& points, double voxel,
+                                 VoxelReduction mode = VoxelReduction::kCentroid) {
+    VoxelCellMap map;
+    std::vector<VoxelCellMap> locals;
+    detail::binParallel(points, Eigen::Isometry3d::Identity(), voxel, 0, locals, map);
+    std::vector<std::pair<uint64_t, const VoxelCell*>> scratch;
+    Eigen::Matrix3Xd out;
+    detail::extractVoxels(map, mode, scratch, out);
+    return out;
+}
+
+// Persistent voxel map fed by a stream of scans
+class VoxelMap {
+public:
+    explicit VoxelMap(double voxel, VoxelReduction mode = VoxelReduction::kCentroid)
+        : voxel_(voxel), mode_(mode) {}
+
+    double voxelSize() const { return voxel_; }
+    size_t size() const { return map_.size(); }
+    uint64_t pointsInserted() const { return inserted_; }
+
+    // Adds a scan given in the sensor frame at pose T_map_sensor
+    template <typename Derived>
+    void insert(const Eigen::MatrixBase<Derived>& scan,
+                const Eigen::Isometry3d& T_map_sensor = Eigen::Isometry3d::Identity()) {
+        detail::binParallel(scan, T_map_sensor, voxel_, inserted_, locals_, map_);
+        inserted_ += static_cast<uint64_t>(scan.cols());
+    }
+
+    // Drops voxels whose representative is farther than radius from center
+    // (a local map that follows the sensor)
+    void pruneOutside(const Eigen::Vector3d& center, double radius) {
+        const double r2 = radius * radius;
+        map_.eraseIf([&](const VoxelKey&, const VoxelCell& c) {
+            return (c.point(mode_) - center).squaredNorm() > r2;
+        });
+    }
+
+    void clear() {
+        map_.clear();
+        inserted_ = 0;
+    }
+
+    // One point per voxel, oldest voxels first
+    void points(Eigen::Matrix3Xd& out) const { detail::extractVoxels(map_, mode_, scratch_, out); }
+
+private:
+    double voxel_;
+    VoxelReduction mode_;
+    uint64_t inserted_ = 0;
+    VoxelCellMap map_;
+    std::vector<VoxelCellMap> locals_;
+    mutable std::vector<std::pair<uint64_t, const VoxelCell*>> scratch_;
+};
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_VOXEL_DOWNSAMPLE_H
@@ -3,6 +3,8 @@
  *
  * Topics: R = I + [w]_x for small rotations
  * Key for Jacobian computation in SLAM optimization
+ *
+ * The exact exp / log maps and their Jacobians (SO3 / SE3): 3.12
  */
 
 #include <iostream>
@@ -10,6 +12,8 @@
 #include <Eigen/Dense>
 #include <Eigen/Geometry>
 
+#include "chapter3/lie_group.h"
+
 int main() {
     std::cout << "=== 3.10 Small Angle Approximation ===\n\n";
 
@@ -20,10 +24,7 @@ int main() {
     Eigen::Vector3d small_omega(0.01, 0.02, 0.03);  // Small rotation
 
     // Skew-symmetric matrix
-    Eigen::Matrix3d omega_skew;
-    omega_skew <<  0,           -small_omega.z(),  small_omega.y(),
-                   small_omega.z(),  0,           -small_omega.x(),
-                  -small_omega.y(),  small_omega.x(),  0;
+    Eigen::Matrix3d omega_skew = eigen_tutorial::skew(small_omega);
 
     // Approximation
     Eigen::Matrix3d R_approx = Eigen::Matrix3d::Identity() + omega_skew;
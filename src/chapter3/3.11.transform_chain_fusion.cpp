@@ -0,0 +1,84 @@
+/**
+ * Chapter 3.11: Fusing Transform Chains
+ *
+ * Topics: Composing a chain once, AffineCompact (3x4), applying to point sets
+ * SLAM: multi-sensor extrinsic chains (lidar -> imu -> base -> world)
+ */
+
+#include <iostream>
+#include <cmath>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "chapter3/transform_chain.h"
+
+int main() {
+    std::cout << "=== 3.11 Fusing Transform Chains ===\n\n";
+
+    // Same chain as 3.9
+    Eigen::Isometry3d T_world_base = Eigen::Isometry3d::Identity();
+    T_world_base.translation() = Eigen::Vector3d(1, 0, 0);
+
+    Eigen::Isometry3d T_base_link1 = Eigen::Isometry3d::Identity();
+    T_base_link1.rotate(Eigen::AngleAxisd(M_PI/4, Eigen::Vector3d::UnitZ()));
+    T_base_link1.translation() = Eigen::Vector3d(0.5, 0, 0.1);
+
+    Eigen::Isometry3d T_link1_link2 = Eigen::Isometry3d::Identity();
+    T_link1_link2.rotate(Eigen::AngleAxisd(-M_PI/6, Eigen::Vector3d::UnitY()));
+    T_link1_link2.translation() = Eigen::Vector3d(0.3, 0, 0);
+
+    Eigen::Isometry3d T_link2_ee = Eigen::Isometry3d::Identity();
+    T_link2_ee.translation() = Eigen::Vector3d(0.2, 0, 0);
+
+    // Applying the links one by one: K = 4 matrix-vector products per point
+    //   p_world = T_world_base * (T_base_link1 * (T_link1_link2 * (T_link2_ee * p)))
+    // Fusing first: 3 small 3x4 products once, then 1 product per point
+    //   p_world = T_world_ee * p
+
+    // 1) Variadic fuse(): chain length fixed in the source, product unrolled
+    eigen_tutorial::Affine34<double> T_fused =
+        eigen_tutorial::fuse(T_world_base, T_base_link1, T_link1_link2, T_link2_ee);
+    std::cout << "Fused 3x4 affine:\n" << T_fused.matrix() << "\n\n";
+
+    // 2) FixedTransformChain<double, 4>: links can be updated, K stays static
+    eigen_tutorial::FixedTransformChain<double, 4> arm(T_world_base, T_base_link1,
+                                                       T_link1_link2, T_link2_ee);
+
+    // 3) TransformChain<double>: length decided at run time, fused lazily
+    eigen_tutorial::TransformChain<double> sensors;
+    sensors.push_back(T_world_base);
+    sensors.push_back(T_base_link1);
+    sensors.push_back(T_link1_link2);
+    sensors.push_back(T_link2_ee);
+
+    Eigen::Isometry3d T_world_ee = T_world_base * T_base_link1 * T_link1_link2 * T_link2_ee;
+    std::cout << "End effector (3.9 chain):     " << T_world_ee.translation().transpose() << "\n";
+    std::cout << "End effector (fixed chain):   " << arm.fused().translation().transpose() << "\n";
+    std::cout << "End effector (dynamic chain): " << sensors.fused().translation().transpose() << "\n\n";
+
+    // Apply to a point set in one fused pass
+    const Eigen::Index n = 100000;
+    eigen_tutorial::PointCloudSoA<double> cloud(n), out;
+    cloud.x.setRandom();
+    cloud.y.setRandom();
+    cloud.z.setRandom();
+    sensors.apply(cloud, out);
+
+    double max_err = 0;
+    for (Eigen::Index i = 0; i < n; ++i) {
+        Eigen::Vector3d p = cloud.point(i);
+        Eigen::Vector3d p_chain = T_world_base * (T_base_link1 * (T_link1_link2 * (T_link2_ee * p)));
+        max_err = std::max(max_err, (p_chain - out.point(i)).norm());
+    }
+    std::cout << "Fused pass vs link-by-link, max error over " << n << " points: " << max_err << "\n";
+
+    // Updating one link only marks the cached product dirty
+    Eigen::Isometry3d T_link1_link2_new = T_link1_link2;
+    T_link1_link2_new.rotate(Eigen::AngleAxisd(0.1, Eigen::Vector3d::UnitY()));
+    sensors.setLink(2, T_link1_link2_new);
+    arm.setLink(2, T_link1_link2_new);
+    std::cout << "After joint update (dynamic): " << sensors.fused().translation().transpose() << "\n";
+    std::cout << "After joint update (fixed):   " << arm.fused().translation().transpose() << "\n";
+
+    return 0;
+}
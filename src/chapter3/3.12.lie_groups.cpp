@@ -0,0 +1,134 @@
+/**
+ * Chapter 3.12: SO(3) / SE(3) Lie Groups
+ *
+ * Topics: exp / log maps, small-angle branches, adjoint, left / right
+ *         Jacobians and their inverses, float vs double
+ * SLAM Applications: Pose increments in Gauss-Newton / LM, on-manifold
+ *                    preintegration, covariance propagation between frames
+ */
+
+#include <cmath>
+#include <iostream>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "chapter3/lie_group.h"
+
+namespace {
+
+using eigen_tutorial::SE3d;
+using eigen_tutorial::SO3d;
+
+// Central differences of the left Jacobian: exp(x + h e_i) exp(x)^-1 ~ exp(h Jl(x) e_i)
+template <typename Group>
+typename Group::Matrix3 numericLeftJacobianSO3(const typename Group::Tangent& x) {
+    const double h = 1e-6;
+    typename Group::Matrix3 J;
+    for (int i = 0; i < 3; ++i) {
+        typename Group::Tangent d = Group::Tangent::Zero();
+        d(i) = h;
+        J.col(i) = ((Group::exp(x + d) * Group::exp(x).inverse()).log() -
+                    (Group::exp(x - d) * Group::exp(x).inverse()).log()) / (2 * h);
+    }
+    return J;
+}
+
+SE3d::Matrix6 numericLeftJacobianSE3(const SE3d::Tangent& xi) {
+    const double h = 1e-6;
+    SE3d::Matrix6 J;
+    for (int i = 0; i < 6; ++i) {
+        SE3d::Tangent d = SE3d::Tangent::Zero();
+        d(i) = h;
+        J.col(i) = ((SE3d::exp(xi + d) * SE3d::exp(xi).inverse()).log() -
+                    (SE3d::exp(xi - d) * SE3d::exp(xi).inverse()).log()) / (2 * h);
+    }
+    return J;
+}
+
+}  // namespace
+
+int main() {
+    std::cout << "=== 3.12 SO(3) / SE(3) Lie Groups ===\n\n";
+
+    // exp / log against AngleAxisd, from tiny angles to almost pi
+    std::cout << "SO3 exp / log vs AngleAxisd:\n";
+    const Eigen::Vector3d axis = Eigen::Vector3d(1, -2, 0.5).normalized();
+    for (double angle : {1e-12, 1e-5, 0.3, 2.0, M_PI - 1e-6}) {
+        const Eigen::Vector3d w = angle * axis;
+        const SO3d R = SO3d::exp(w);
+        const Eigen::Matrix3d R_aa = Eigen::AngleAxisd(angle, axis).toRotationMatrix();
+        std::cout << "    theta = " << angle << ": |R - R_aa| = " << (R.matrix() - R_aa).norm()
+                  << ", |log(exp(w)) - w| / |w| = " << (R.log() - w).norm() / angle << "\n";
+    }
+
+    // R = I + [w]_x is exp's first-order term (3.10)
+    const Eigen::Vector3d small(0.01, 0.02, 0.03);
+    std::cout << "|exp(w) - (I + [w]_x)| for |w| = " << small.norm() << ": "
+              << (SO3d::exp(small).matrix() - (Eigen::Matrix3d::Identity() + eigen_tutorial::skew(small))).norm()
+              << "\n\n";
+
+    // Jacobians: analytic vs central differences, small and large angles
+    std::cout << "SO3 Jacobians:\n";
+    for (double angle : {1e-3, 0.2, 1.0, 3.0}) {
+        const Eigen::Vector3d w = angle * axis;
+        const Eigen::Matrix3d Jl = SO3d::leftJacobian(w);
+        std::cout << "    theta = " << angle << ": |Jl - numeric| = " << (Jl - numericLeftJacobianSO3<SO3d>(w)).norm()
+                  << ", |Jl Jl^-1 - I| = " << (Jl * SO3d::leftJacobianInverse(w) - Eigen::Matrix3d::Identity()).norm()
+                  << ", |Jr - R^T Jl| = " << (SO3d::rightJacobian(w) - SO3d::exp(w).matrix().transpose() * Jl).norm()
+                  << "\n";
+    }
+
+    std::cout << "\nSE3 Jacobians (xi = [rho; phi]):\n";
+    for (double angle : {1e-3, 0.2, 1.0, 3.0}) {
+        SE3d::Tangent xi;
+        xi << 0.5, -1.0, 2.0, angle * axis;
+        const SE3d::Matrix6 Jl = SE3d::leftJacobian(xi);
+        std::cout << "    theta = " << angle << ": |Jl - numeric| = " << (Jl - numericLeftJacobianSE3(xi)).norm()
+                  << ", |Jl Jl^-1 - I| = "
+                  << (Jl * SE3d::leftJacobianInverse(xi) - SE3d::Matrix6::Identity()).norm() << "\n";
+    }
+
+    // Adjoint: T exp(xi) T^-1 = exp(Ad(T) xi)
+    SE3d::Tangent xi_T, xi;
+    xi_T << 1, 2, 3, 0.4, -0.3, 0.2;
+    xi << -0.2, 0.1, 0.3, 0.05, 0.1, -0.2;
+    const SE3d T = SE3d::exp(xi_T);
+    std::cout << "\n|T exp(xi) T^-1 - exp(Ad(T) xi)| = "
+              << ((T * SE3d::exp(xi) * T.inverse()).matrix() - SE3d::exp(T.adjoint() * xi).matrix()).norm() << "\n";
+
+    // 6.6's pose Jacobian dp'/d[dt, dw] = [I, -R [p]_x] from a right perturbation
+    const Eigen::Vector3d p(1, 2, 3);
+    Eigen::Matrix<double, 3, 6> J_point;
+    J_point << Eigen::Matrix3d::Identity(), -T.rotationMatrix() * eigen_tutorial::skew(p);
+    Eigen::Matrix<double, 3, 6> J_num;
+    for (int i = 0; i < 6; ++i) {
+        SE3d::Tangent d = SE3d::Tangent::Zero();
+        d(i) = 1e-6;
+        // Translation increments in the world frame, rotation on the right
+        const SE3d T_plus(T.so3() * eigen_tutorial::SO3d::exp(d.tail<3>()), T.translation() + d.head<3>());
+        J_num.col(i) = (T_plus * p - T * p) / 1e-6;
+    }
+    std::cout << "|dp'/dpose - numeric| = " << (J_point - J_num).norm() << "\n";
+
+    // Isometry3d interop
+    const Eigen::Isometry3d iso = T.isometry();
+    std::cout << "|T * p - Isometry3d * p| = " << (T * p - iso * p).norm()
+              << ", |log(SE3(iso)) - xi_T| = " << (SE3d(iso).log() - xi_T).norm() << "\n\n";
+
+    // float: same code, ~1e-7 relative accuracy, including the Taylor branches
+    std::cout << "float vs double:\n";
+    for (double angle : {1e-4, 0.05, 1.0}) {
+        SE3d::Tangent x;
+        x << 0.5, -1.0, 2.0, angle * axis;
+        const eigen_tutorial::SE3f::Tangent xf = x.cast<float>();
+        std::cout << "    theta = " << angle << ": |exp_f - exp_d| = "
+                  << (eigen_tutorial::SE3f::exp(xf).matrix().cast<double>() - SE3d::exp(x).matrix()).norm()
+                  << ", |Jl_f - Jl_d| = "
+                  << (eigen_tutorial::SE3f::leftJacobian(xf).cast<double>() - SE3d::leftJacobian(x)).norm()
+                  << ", |Jl^-1_f - Jl^-1_d| = "
+                  << (eigen_tutorial::SE3f::leftJacobianInverse(xf).cast<double>() - SE3d::leftJacobianInverse(x)).norm()
+                  << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * Chapter 3.13: Transform Trees
+ *
+ * Topics: Frame trees, cached root transforms, subtree invalidation,
+ *         seqlock reads under concurrent updates
+ * SLAM Applications: tf-style frame lookups (world / odom / base / sensors),
+ *                    robot arms, sensor extrinsics shared across threads
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "chapter3/transform_tree.h"
+
+namespace {
+
+Eigen::Isometry3d makePose(double yaw, const Eigen::Vector3d& t) {
+    Eigen::Isometry3d T = Eigen::Isometry3d::Identity();
+    T.rotate(Eigen::AngleAxisd(yaw, Eigen::Vector3d::UnitZ()));
+    T.translation() = t;
+    return T;
+}
+
+}  // namespace
+
+int main() {
+    std::cout << "=== 3.13 Transform Trees ===\n\n";
+
+    // world -> odom -> base -> {lidar, camera, imu, link1 -> link2 -> ee}
+    eigen_tutorial::TransformTreed tree(16);
+    const int world = 0;
+    const int odom = tree.addFrame(world, makePose(0.3, Eigen::Vector3d(5, 2, 0)));
+    const int base = tree.addFrame(odom, makePose(0.1, Eigen::Vector3d(1, 0, 0)));
+    const int lidar = tree.addFrame(base, makePose(0, Eigen::Vector3d(0.2, 0, 1.2)));
+    const int camera = tree.addFrame(base, makePose(-M_PI / 2, Eigen::Vector3d(0.4, 0.1, 0.8)));
+    const int imu = tree.addFrame(base, makePose(0, Eigen::Vector3d(0, 0, 0.3)));
+    const int link1 = tree.addFrame(base, makePose(M_PI / 4, Eigen::Vector3d(0.5, 0, 0.1)));
+    const int link2 = tree.addFrame(link1, makePose(-M_PI / 6, Eigen::Vector3d(0.3, 0, 0)));
+    const int ee = tree.addFrame(link2, makePose(0, Eigen::Vector3d(0.2, 0, 0)));
+    std::cout << "Frames: " << tree.size() << " of " << tree.maxFrames() << "\n";
+
+    // Lookup vs composing the chain by hand (3.9)
+    const Eigen::Isometry3d T_world_ee = makePose(0.3, Eigen::Vector3d(5, 2, 0)) *
+                                         makePose(0.1, Eigen::Vector3d(1, 0, 0)) *
+                                         makePose(M_PI / 4, Eigen::Vector3d(0.5, 0, 0.1)) *
+                                         makePose(-M_PI / 6, Eigen::Vector3d(0.3, 0, 0)) *
+                                         makePose(0, Eigen::Vector3d(0.2, 0, 0));
+    std::cout << "|lookup(world, ee) - hand-composed chain| = "
+              << (tree.lookup(world, ee).matrix() - T_world_ee.matrix().topRows<3>()).norm() << "\n";
+    const eigen_tutorial::TransformTreed::Transform T_camera_lidar = tree.lookup(camera, lidar);
+    std::cout << "T_camera_lidar translation: " << T_camera_lidar.translation().transpose() << "\n\n";
+
+    // Updates refresh only the subtree below the changed link
+    std::cout << "Cached transforms recomputed by setLink:\n"
+              << "    link2 (arm joint): " << tree.setLink(link2, makePose(-M_PI / 5, Eigen::Vector3d(0.3, 0, 0)))
+              << "\n    odom (localization): " << tree.setLink(odom, makePose(0.31, Eigen::Vector3d(5.1, 2, 0)))
+              << "\n    imu (calibration): " << tree.setLink(imu, makePose(0.01, Eigen::Vector3d(0, 0, 0.3)))
+              << "\n\n";
+
+    // Readers vs a writer: the writer moves odom and the arm as fast as it
+    // can; readers check that camera <- lidar (both rigid on base) never
+    // changes, which a lookup mixing two tree states would break
+    const int readers = std::max(1u, std::min(3u, std::thread::hardware_concurrency()));
+    std::atomic<bool> done(false);
+    std::vector<long> lookups(readers, 0), retries(readers, 0);
+    std::vector<double> worst_error(readers, 0), worst_ns(readers, 0);
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&, r] {
+            int retry_count = 0;
+            while (!done) {
+                const auto t0 = std::chrono::steady_clock::now();
+                const eigen_tutorial::TransformTreed::Transform T = tree.lookup(camera, lidar, &retry_count);
+                const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+                worst_ns[r] = std::max(worst_ns[r], ns);
+                worst_error[r] = std::max(worst_error[r], (T.matrix() - T_camera_lidar.matrix()).cwiseAbs().maxCoeff());
+                tree.lookup(world, ee, &retry_count);
+                lookups[r] += 2;
+            }
+            retries[r] = retry_count;
+        });
+    }
+    long writes = 0;
+    const auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(200)) {
+        const double s = 1e-3 * writes;
+        tree.setLink(odom, makePose(0.3 + 0.1 * std::sin(s), Eigen::Vector3d(5 + s, 2, 0)));
+        tree.setLink(link1, makePose(M_PI / 4 * std::cos(s), Eigen::Vector3d(0.5, 0, 0.1)));
+        writes += 2;
+    }
+    done = true;
+    for (std::thread& t : threads) t.join();
+
+    long total_lookups = 0, total_retries = 0;
+    double error = 0, slowest = 0;
+    for (int r = 0; r < readers; ++r) {
+        total_lookups += lookups[r];
+        total_retries += retries[r];
+        error = std::max(error, worst_error[r]);
+        slowest = std::max(slowest, worst_ns[r]);
+    }
+    std::cout << readers << " readers vs 1 writer for 200 ms: " << writes << " writes, " << total_lookups
+              << " lookups, " << total_retries << " retries\n"
+              << "    max |T_camera_lidar - expected| = " << error << ", slowest lookup " << slowest / 1000
+              << " us (includes preemption)\n"
+              << "    tree version " << tree.version() << "\n";
+
+    return 0;
+}
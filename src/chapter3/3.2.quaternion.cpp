@@ -3,6 +3,8 @@
  *
  * Topics: Quaternion creation, operations, conversion
  * Advantages: Compact, no gimbal lock, easy interpolation, numerically stable
+ *
+ * Batched SLERP over a time-indexed pose buffer: 7.11
  */
 
 #include <iostream>
@@ -3,6 +3,8 @@
  *
  * Topics: Rotation by angle theta around axis n
  * Also known as rotation vector in SLAM optimization
+ *
+ * Rotation vectors as the SO(3) exp / log maps, with Jacobians: 3.12
  */
 
 #include <iostream>
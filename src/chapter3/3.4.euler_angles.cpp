@@ -3,6 +3,8 @@
  *
  * WARNING: Euler angles have gimbal lock and convention ambiguity
  * Use only for human-readable output, NOT for computation
+ *
+ * Batched ZYX conversion that stays exact at gimbal lock: 3.14
  */
 
 #include <iostream>
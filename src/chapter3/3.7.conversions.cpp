@@ -2,6 +2,8 @@
  * Chapter 3.7: Conversions Between Representations
  *
  * Topics: Converting between rotation matrix, quaternion, angle-axis, rotation vector
+ *
+ * Converting millions of rotations at once (SoA, branch-free): 3.14
  */
 
 #include <iostream>
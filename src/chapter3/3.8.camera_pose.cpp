@@ -2,6 +2,8 @@
  * Chapter 3.8: Practical - Camera Pose in SLAM
  *
  * Topics: T_world_camera vs T_camera_world, transforming points
+ *
+ * Cached frame trees shared between threads: 3.13
  */
 
 #include <iostream>
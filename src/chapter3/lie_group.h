@@ -0,0 +1,296 @@
+/**
+ * SO(3) and SE(3) as Lie groups: exp, log, adjoint and Jacobians (see 3.12)
+ *
+ * 3.3 (rotation vectors), 3.10 (R = I + [w]_x) and 6.6 (pose Jacobians) all
+ * use pieces of the same theory. Here they are in one place, on fixed-size
+ * types only, so nothing allocates:
+ *
+ *   skew(v) / vee(S)       3-vector <-> 3x3 skew-symmetric matrix
+ *   SO3<S>                 unit quaternion; exp / log of rotation vectors
+ *   SE3<S>                 SO3 + translation; tangent xi = [rho; phi]
+ *                          (translation first, as in 6.6)
+ *
+ * Conventions follow Barfoot, "State Estimation for Robotics" (2017):
+ *
+ *   exp(xi + d) ~ exp(Jl(xi) d) exp(xi) ~ exp(xi) exp(Jr(xi) d)
+ *   T exp(xi) T^-1 = exp(Ad(T) xi)
+ *
+ * with Jr(xi) = Jl(-xi). Near theta = 0 the closed forms are 0 / 0:
+ *
+ *   - exp / log only divide by theta and switch to two Taylor terms below
+ *     theta^2 = sqrt(epsilon), where those are exact to machine precision
+ *   - the Jacobian coefficients, e.g. (theta - sin theta) / theta^3, lose
+ *     digits to cancellation long before that (for float, all of them at
+ *     theta ~ 0.02), so they use five Taylor terms up to theta^2 = 0.1,
+ *     beyond which the closed forms are accurate for float and double
+ *
+ * Products of SO3 do not renormalize the quaternion; call normalize() after
+ * long chains of compositions.
+ */
+
+#ifndef EIGEN_TUTORIAL_LIE_GROUP_H
+#define EIGEN_TUTORIAL_LIE_GROUP_H
+
+#include <cmath>
+#include <limits>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+namespace eigen_tutorial {
+
+// theta^2 below which exp / log use their Taylor series
+template <typename Scalar>
+Scalar kLieSmallAngle2() {
+    return std::sqrt(std::numeric_limits<Scalar>::epsilon());
+}
+
+// theta^2 below which the Jacobian coefficients use their Taylor series
+const double kLieSeriesCutoff2 = 0.1;
+
+namespace detail {
+
+// c0 + c1 x + c2 x^2 + c3 x^3 + c4 x^4 (x = theta^2)
+template <typename Scalar>
+Scalar lieSeries(Scalar x, double c0, double c1, double c2, double c3, double c4) {
+    return Scalar(c0) + x * (Scalar(c1) + x * (Scalar(c2) + x * (Scalar(c3) + x * Scalar(c4))));
+}
+
+}  // namespace detail
+
+// [v]_x, so that skew(a) * b = a.cross(b)
+template <typename Derived>
+Eigen::Matrix<typename Derived::Scalar, 3, 3> skew(const Eigen::MatrixBase<Derived>& v) {
+    EIGEN_STATIC_ASSERT_VECTOR_SPECIFIC_SIZE(Derived, 3);
+    Eigen::Matrix<typename Derived::Scalar, 3, 3> S;
+    S <<     0, -v.z(),  v.y(),
+         v.z(),      0, -v.x(),
+        -v.y(),  v.x(),      0;
+    return S;
+}
+
+// Inverse of skew() (reads the lower triangle)
+template <typename Derived>
+Eigen::Matrix<typename Derived::Scalar, 3, 1> vee(const Eigen::MatrixBase<Derived>& S) {
+    return Eigen::Matrix<typename Derived::Scalar, 3, 1>(S(2, 1), S(0, 2), S(1, 0));
+}
+
+template <typename Scalar>
+class SO3 {
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef Eigen::Matrix<Scalar, 3, 1> Tangent;
+    typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+    typedef Eigen::Quaternion<Scalar> Quaternion;
+
+    SO3() : q_(Quaternion::Identity()) {}
+    // q must be unit length
+    explicit SO3(const Quaternion& q) : q_(q) {}
+    // R must be a rotation matrix
+    explicit SO3(const Matrix3& R) : q_(R) {}
+
+    // Rotation by |w| around w / |w|
+    static SO3 exp(const Tangent& w) {
+        const Scalar theta2 = w.squaredNorm();
+        Scalar real, imag;  // q = (real, imag * w)
+        if (theta2 < kLieSmallAngle2<Scalar>()) {
+            real = 1 - theta2 / 8 + theta2 * theta2 / 384;
+            imag = Scalar(0.5) - theta2 / 48 + theta2 * theta2 / 3840;
+        } else {
+            const Scalar theta = std::sqrt(theta2);
+            real = std::cos(theta / 2);
+            imag = std::sin(theta / 2) / theta;
+        }
+        return SO3(Quaternion(real, imag * w.x(), imag * w.y(), imag * w.z()));
+    }
+
+    // Rotation vector with angle in [0, pi]
+    Tangent log() const {
+        // q and -q are the same rotation; w >= 0 picks the angle <= pi
+        const Scalar w = q_.w() < 0 ? -q_.w() : q_.w();
+        const Tangent v = q_.w() < 0 ? Tangent(-q_.vec()) : Tangent(q_.vec());
+        const Scalar n2 = v.squaredNorm();
+        Scalar factor;  // log = factor * v
+        if (n2 < kLieSmallAngle2<Scalar>()) {
+            factor = 2 / w - Scalar(2) / 3 * n2 / (w * w * w);
+        } else {
+            const Scalar n = std::sqrt(n2);
+            factor = 2 * std::atan2(n, w) / n;
+        }
+        return factor * v;
+    }
+
+    SO3 operator*(const SO3& other) const { return SO3(q_ * other.q_); }
+    Tangent operator*(const Tangent& p) const { return q_ * p; }
+    SO3 inverse() const { return SO3(q_.conjugate()); }
+    void normalize() { q_.normalize(); }
+
+    const Quaternion& unitQuaternion() const { return q_; }
+    Matrix3 matrix() const { return q_.toRotationMatrix(); }
+    // Ad(R) = R for rotations
+    Matrix3 adjoint() const { return matrix(); }
+
+    template <typename NewScalar>
+    SO3<NewScalar> cast() const {
+        return SO3<NewScalar>(q_.template cast<NewScalar>());
+    }
+
+    // Jl(w) = I + (1 - cos t) / t^2 [w]_x + (t - sin t) / t^3 [w]_x^2
+    static Matrix3 leftJacobian(const Tangent& w) {
+        const Scalar theta2 = w.squaredNorm();
+        Scalar a, b;
+        if (theta2 < Scalar(kLieSeriesCutoff2)) {
+            a = detail::lieSeries(theta2, 1.0 / 2, -1.0 / 24, 1.0 / 720, -1.0 / 40320, 1.0 / 3628800);
+            b = detail::lieSeries(theta2, 1.0 / 6, -1.0 / 120, 1.0 / 5040, -1.0 / 362880, 1.0 / 39916800);
+        } else {
+            const Scalar theta = std::sqrt(theta2);
+            a = (1 - std::cos(theta)) / theta2;
+            b = (theta - std::sin(theta)) / (theta2 * theta);
+        }
+        const Matrix3 W = skew(w);
+        return Matrix3::Identity() + a * W + b * W * W;
+    }
+
+    // Jl(w)^-1 = I - [w]_x / 2 + (1 / t^2 - (1 + cos t) / (2 t sin t)) [w]_x^2
+    static Matrix3 leftJacobianInverse(const Tangent& w) {
+        const Scalar theta2 = w.squaredNorm();
+        Scalar c;
+        if (theta2 < Scalar(kLieSeriesCutoff2)) {
+            c = detail::lieSeries(theta2, 1.0 / 12, 1.0 / 720, 1.0 / 30240, 1.0 / 1209600, 1.0 / 47900160);
+        } else {
+            const Scalar theta = std::sqrt(theta2);
+            c = 1 / theta2 - (1 + std::cos(theta)) / (2 * theta * std::sin(theta));
+        }
+        const Matrix3 W = skew(w);
+        return Matrix3::Identity() - Scalar(0.5) * W + c * W * W;
+    }
+
+    static Matrix3 rightJacobian(const Tangent& w) { return leftJacobian(-w); }
+    static Matrix3 rightJacobianInverse(const Tangent& w) { return leftJacobianInverse(-w); }
+
+private:
+    Quaternion q_;
+};
+
+template <typename Scalar>
+class SE3 {
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef Eigen::Matrix<Scalar, 6, 1> Tangent;  // [rho (translation); phi (rotation)]
+    typedef Eigen::Matrix<Scalar, 6, 6> Matrix6;
+    typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+    typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+    typedef Eigen::Matrix<Scalar, 4, 4> Matrix4;
+    typedef Eigen::Transform<Scalar, 3, Eigen::Isometry> Isometry;
+
+    SE3() : t_(Vector3::Zero()) {}
+    SE3(const SO3<Scalar>& R, const Vector3& t) : R_(R), t_(t) {}
+    explicit SE3(const Isometry& T) : R_(Matrix3(T.linear())), t_(T.translation()) {}
+
+    // exp([rho; phi]) = (exp(phi), Jl(phi) rho)
+    static SE3 exp(const Tangent& xi) {
+        const Vector3 phi = xi.template tail<3>();
+        return SE3(SO3<Scalar>::exp(phi), SO3<Scalar>::leftJacobian(phi) * xi.template head<3>());
+    }
+
+    Tangent log() const {
+        const Vector3 phi = R_.log();
+        Tangent xi;
+        xi << SO3<Scalar>::leftJacobianInverse(phi) * t_, phi;
+        return xi;
+    }
+
+    SE3 operator*(const SE3& other) const { return SE3(R_ * other.R_, R_ * other.t_ + t_); }
+    Vector3 operator*(const Vector3& p) const { return R_ * p + t_; }
+    SE3 inverse() const {
+        const SO3<Scalar> Rinv = R_.inverse();
+        return SE3(Rinv, -(Rinv * t_));
+    }
+    void normalize() { R_.normalize(); }
+
+    const SO3<Scalar>& so3() const { return R_; }
+    const Vector3& translation() const { return t_; }
+    Matrix3 rotationMatrix() const { return R_.matrix(); }
+    Matrix4 matrix() const {
+        Matrix4 T = Matrix4::Identity();
+        T.template topLeftCorner<3, 3>() = R_.matrix();
+        T.template topRightCorner<3, 1>() = t_;
+        return T;
+    }
+    Isometry isometry() const {
+        Isometry T;
+        T.linear() = R_.matrix();
+        T.translation() = t_;
+        T.makeAffine();
+        return T;
+    }
+
+    // Ad(T) = [R  [t]_x R; 0  R]
+    Matrix6 adjoint() const {
+        const Matrix3 R = R_.matrix();
+        Matrix6 Ad;
+        Ad << R, skew(t_) * R, Matrix3::Zero(), R;
+        return Ad;
+    }
+
+    template <typename NewScalar>
+    SE3<NewScalar> cast() const {
+        return SE3<NewScalar>(R_.template cast<NewScalar>(), t_.template cast<NewScalar>());
+    }
+
+    // Jl(xi) = [Jl(phi)  Q(rho, phi); 0  Jl(phi)]
+    static Matrix6 leftJacobian(const Tangent& xi) {
+        const Vector3 rho = xi.template head<3>(), phi = xi.template tail<3>();
+        const Matrix3 J = SO3<Scalar>::leftJacobian(phi);
+        Matrix6 Jl;
+        Jl << J, q(rho, phi), Matrix3::Zero(), J;
+        return Jl;
+    }
+
+    // Jl(xi)^-1 = [J^-1  -J^-1 Q J^-1; 0  J^-1]
+    static Matrix6 leftJacobianInverse(const Tangent& xi) {
+        const Vector3 rho = xi.template head<3>(), phi = xi.template tail<3>();
+        const Matrix3 Jinv = SO3<Scalar>::leftJacobianInverse(phi);
+        Matrix6 Jl;
+        Jl << Jinv, -Jinv * q(rho, phi) * Jinv, Matrix3::Zero(), Jinv;
+        return Jl;
+    }
+
+    static Matrix6 rightJacobian(const Tangent& xi) { return leftJacobian(-xi); }
+    static Matrix6 rightJacobianInverse(const Tangent& xi) { return leftJacobianInverse(-xi); }
+
+private:
+    // Barfoot's Q(rho, phi), the translation-rotation block of Jl
+    static Matrix3 q(const Vector3& rho, const Vector3& phi) {
+        const Scalar theta2 = phi.squaredNorm();
+        Scalar c1, c2, c3;
+        if (theta2 < Scalar(kLieSeriesCutoff2)) {
+            c1 = detail::lieSeries(theta2, 1.0 / 6, -1.0 / 120, 1.0 / 5040, -1.0 / 362880, 1.0 / 39916800);
+            c2 = detail::lieSeries(theta2, 1.0 / 24, -1.0 / 720, 1.0 / 40320, -1.0 / 3628800, 1.0 / 479001600);
+            c3 = detail::lieSeries(theta2, 1.0 / 120, -2.0 / 5040, 3.0 / 362880, -4.0 / 39916800,
+                                   5.0 / 6227020800);
+        } else {
+            const Scalar theta = std::sqrt(theta2), s = std::sin(theta), c = std::cos(theta);
+            c1 = (theta - s) / (theta2 * theta);
+            c2 = (theta2 + 2 * c - 2) / (2 * theta2 * theta2);
+            c3 = (2 * theta - 3 * s + theta * c) / (2 * theta2 * theta2 * theta);
+        }
+        const Matrix3 P = skew(phi), V = skew(rho);
+        const Matrix3 PV = P * V, VP = V * P, PVP = PV * P;
+        return Scalar(0.5) * V + c1 * (PV + VP + PVP) + c2 * (P * PV + VP * P - 3 * PVP) +
+               c3 * (PVP * P + P * PVP);
+    }
+
+    SO3<Scalar> R_;
+    Vector3 t_;
+};
+
+typedef SO3<double> SO3d;
+typedef SO3<float> SO3f;
+typedef SE3<double> SE3d;
+typedef SE3<float> SE3f;
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_LIE_GROUP_H
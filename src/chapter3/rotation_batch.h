@@ -0,0 +1,483 @@
+/**
+ * Batched rotation conversions on SoA arrays (see 3.14)
+ *
+ * 3.4 and 3.7 convert one rotation at a time through Eigen's constructors,
+ * which branch on the data (Quaterniond(R) picks the largest diagonal entry
+ * with if / else). Over millions of rotations in arrays that is one
+ * mispredict-prone scalar path per rotation. Here every representation is a
+ * set of component arrays,
+ *
+ *   RotationMatrices<S>   m[9], row-major: m[3 * row + col]
+ *   Quaternions<S>        w, x, y, z
+ *   AngleAxes<S>          angle, x, y, z (unit axis)
+ *   RotationVectors<S>    x, y, z (angle * axis)
+ *   EulerAnglesZYX<S>     yaw, pitch, roll: R = Rz(yaw) Ry(pitch) Rx(roll)
+ *
+ * and convertRotations(in, out, n) converts between any two of them. The
+ * kernels are straight-line loops: data-dependent choices are selects, so
+ * the compiler vectorizes the algebraic ones (matrix <-> quaternion,
+ * normalization) across lanes, with square roots done by Eigen's packet
+ * math. The ones that need sin / cos / atan2 call those per element (the
+ * compiler has no vector versions without -ffast-math) and the rest of the
+ * loop around them stays branch-free. Pairs without a direct kernel go
+ * through quaternions, kRotationBlock at a time on the stack. Batches are
+ * split across threads.
+ *
+ * Conventions and error bounds: every pair reproduces the rotation matrix
+ * to within 10 eps (2e-15 in double, measured in 3.14 over random, tiny,
+ * near-pi and gimbal-lock rotations), the same as Eigen's per-rotation
+ * conversions.
+ *
+ *   - matrix -> quaternion: Shepperd's method, selecting the largest of
+ *     4w^2, 4x^2, 4y^2, 4z^2 (always >= 1 for a rotation), so nothing
+ *     small is divided or square-rooted. Output has w >= 0.
+ *   - quaternion -> matrix: the usual quadratic form.
+ *   - quaternion / rotation vector / angle-axis: angle = 2 atan2(|v|, w),
+ *     accurate from 0 to pi (no acos); the series branches of 3.12 below
+ *     theta^2 = sqrt(eps). Angles come out in [0, pi]. A zero rotation has
+ *     axis (1, 0, 0), as in Eigen.
+ *   - Euler ZYX: yaw in (-pi, pi], pitch in [-pi/2, pi/2], roll in (-pi, pi]
+ *     (Eigen's eulerAngles(2, 1, 0) instead keeps yaw in [0, pi]). Roll is
+ *     computed from yaw and the matrix, so at gimbal lock (|pitch| = pi/2)
+ *     the angles still reproduce the rotation to a few eps.
+ *
+ * orthonormalize = true accepts inputs that have drifted off SO(3):
+ * quaternions and angle-axis axes are normalized, and matrices are mapped
+ * to the normalized Shepperd quaternion, i.e. projected back onto SO(3) to
+ * first order in the drift. Rotation vectors and Euler angles are always
+ * valid and are not affected.
+ */
+
+#ifndef EIGEN_TUTORIAL_ROTATION_BATCH_H
+#define EIGEN_TUTORIAL_ROTATION_BATCH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <Eigen/Core>
+
+#include "chapter3/lie_group.h"
+#include "common/parallel.h"
+
+namespace eigen_tutorial {
+
+// Rotations per stack block when converting through quaternions
+const size_t kRotationBlock = 256;
+// Below this many rotations per thread, conversions stay on one thread
+const size_t kRotationMinChunk = 1 << 14;
+
+template <typename S>
+struct RotationMatrices {
+    typedef S Scalar;
+    S* m[9];  // Row-major: m[3 * row + col]
+
+    RotationMatrices offset(size_t k) const {
+        RotationMatrices r;
+        for (int i = 0; i < 9; ++i) r.m[i] = m[i] + k;
+        return r;
+    }
+};
+
+template <typename S>
+struct Quaternions {
+    typedef S Scalar;
+    S* w;
+    S* x;
+    S* y;
+    S* z;
+
+    Quaternions offset(size_t k) const { return Quaternions{w + k, x + k, y + k, z + k}; }
+};
+
+template <typename S>
+struct AngleAxes {
+    typedef S Scalar;
+    S* angle;
+    S* x;
+    S* y;
+    S* z;
+
+    AngleAxes offset(size_t k) const { return AngleAxes{angle + k, x + k, y + k, z + k}; }
+};
+
+template <typename S>
+struct RotationVectors {
+    typedef S Scalar;
+    S* x;
+    S* y;
+    S* z;
+
+    RotationVectors offset(size_t k) const { return RotationVectors{x + k, y + k, z + k}; }
+};
+
+template <typename S>
+struct EulerAnglesZYX {
+    typedef S Scalar;
+    S* yaw;
+    S* pitch;
+    S* roll;
+
+    EulerAnglesZYX offset(size_t k) const { return EulerAnglesZYX{yaw + k, pitch + k, roll + k}; }
+};
+
+namespace detail {
+
+template <typename From, typename To>
+void convertViaQuaternions(const From& in, const To& out, size_t n, bool orthonormalize);
+
+// k[i] = 1 / sqrt(k[i]) with Eigen's packet math: std::sqrt in a loop keeps
+// a branch to set errno, which stops the compiler from vectorizing it
+template <typename S>
+void rsqrtInPlace(S* k, size_t n) {
+    Eigen::Map<Eigen::Array<S, Eigen::Dynamic, 1>> a(k, static_cast<Eigen::Index>(n));
+    a = a.rsqrt();
+}
+
+// The algebraic kernels take their arrays as restrict-qualified parameters:
+// with a dozen arrays the compiler cannot prove they do not overlap and
+// would not vectorize otherwise. Normalize is a template parameter for the
+// same reason.
+
+template <bool Normalize, typename S>
+void normalizeQuaternions(const S* __restrict iw, const S* __restrict ix, const S* __restrict iy,
+                          const S* __restrict iz, S* __restrict ow, S* __restrict ox, S* __restrict oy,
+                          S* __restrict oz, S* __restrict k, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        const S w = iw[i], x = ix[i], y = iy[i], z = iz[i];
+        k[i] = Normalize ? w * w + x * x + y * y + z * z : S(1);
+    }
+    rsqrtInPlace(k, n);
+    for (size_t i = 0; i < n; ++i) {
+        ow[i] = k[i] * iw[i];
+        ox[i] = k[i] * ix[i];
+        oy[i] = k[i] * iy[i];
+        oz[i] = k[i] * iz[i];
+    }
+}
+
+template <typename S>
+void convertBlock(const Quaternions<S>& in, const Quaternions<S>& out, size_t n, bool orthonormalize) {
+    S k[kRotationBlock];
+    for (size_t b = 0; b < n; b += kRotationBlock) {
+        const size_t len = std::min(kRotationBlock, n - b);
+        const Quaternions<S> i = in.offset(b), o = out.offset(b);
+        if (orthonormalize) {
+            normalizeQuaternions<true>(i.w, i.x, i.y, i.z, o.w, o.x, o.y, o.z, k, len);
+        } else {
+            normalizeQuaternions<false>(i.w, i.x, i.y, i.z, o.w, o.x, o.y, o.z, k, len);
+        }
+    }
+}
+
+// Shepperd's method, pass 1: the unnormalized quaternion u = 4 t q of the
+// case with the largest t, chosen with selects, and |u|^2 (4 t for an exact
+// rotation)
+template <bool Normalize, typename S>
+void shepperdCandidates(const S* __restrict m00, const S* __restrict m01, const S* __restrict m02,
+                        const S* __restrict m10, const S* __restrict m11, const S* __restrict m12,
+                        const S* __restrict m20, const S* __restrict m21, const S* __restrict m22,
+                        S* __restrict uw, S* __restrict ux, S* __restrict uy, S* __restrict uz,
+                        S* __restrict norm2, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        const S r00 = m00[i], r01 = m01[i], r02 = m02[i];
+        const S r10 = m10[i], r11 = m11[i], r12 = m12[i];
+        const S r20 = m20[i], r21 = m21[i], r22 = m22[i];
+        // 4w^2, 4x^2, 4y^2, 4z^2
+        const S t0 = 1 + r00 + r11 + r22;
+        const S t1 = 1 + r00 - r11 - r22;
+        const S t2 = 1 - r00 + r11 - r22;
+        const S t3 = 1 - r00 - r11 + r22;
+        const S d0 = r21 - r12, d1 = r02 - r20, d2 = r10 - r01;
+        const S s01 = r01 + r10, s02 = r02 + r20, s12 = r12 + r21;
+
+        const bool use1 = t1 > t0;
+        S t = use1 ? t1 : t0;
+        const bool use2 = t2 > t;
+        t = use2 ? t2 : t;
+        const bool use3 = t3 > t;
+        t = use3 ? t3 : t;
+
+        // Cases: (t0, d0, d1, d2), (d0, t1, s01, s02), (d1, s01, t2, s12),
+        // (d2, s02, s12, t3)
+        S qw = use1 ? d0 : t0, qx = use1 ? t1 : d0, qy = use1 ? s01 : d1, qz = use1 ? s02 : d2;
+        qw = use2 ? d1 : qw;
+        qx = use2 ? s01 : qx;
+        qy = use2 ? t2 : qy;
+        qz = use2 ? s12 : qz;
+        qw = use3 ? d2 : qw;
+        qx = use3 ? s02 : qx;
+        qy = use3 ? s12 : qy;
+        qz = use3 ? t3 : qz;
+
+        norm2[i] = Normalize ? qw * qw + qx * qx + qy * qy + qz * qz : 4 * t;
+        uw[i] = qw;
+        ux[i] = qx;
+        uy[i] = qy;
+        uz[i] = qz;
+    }
+}
+
+// Pass 3: q = u / |u|, flipped so that w >= 0
+template <typename S>
+void scaleQuaternions(const S* __restrict k, S* __restrict w, S* __restrict x, S* __restrict y,
+                      S* __restrict z, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        const S ki = w[i] < 0 ? -k[i] : k[i];
+        w[i] *= ki;
+        x[i] *= ki;
+        y[i] *= ki;
+        z[i] *= ki;
+    }
+}
+
+template <typename S>
+void convertBlock(const RotationMatrices<S>& in, const Quaternions<S>& out, size_t n, bool orthonormalize) {
+    S k[kRotationBlock];
+    for (size_t b = 0; b < n; b += kRotationBlock) {
+        const size_t len = std::min(kRotationBlock, n - b);
+        const RotationMatrices<S> r = in.offset(b);
+        const Quaternions<S> q = out.offset(b);
+        if (orthonormalize) {
+            shepperdCandidates<true>(r.m[0], r.m[1], r.m[2], r.m[3], r.m[4], r.m[5], r.m[6], r.m[7], r.m[8], q.w,
+                                     q.x, q.y, q.z, k, len);
+        } else {
+            shepperdCandidates<false>(r.m[0], r.m[1], r.m[2], r.m[3], r.m[4], r.m[5], r.m[6], r.m[7], r.m[8], q.w,
+                                      q.x, q.y, q.z, k, len);
+        }
+        rsqrtInPlace(k, len);
+        scaleQuaternions(k, q.w, q.x, q.y, q.z, len);
+    }
+}
+
+template <bool Normalize, typename S>
+void quaternionsToMatrices(const S* __restrict iw, const S* __restrict ix, const S* __restrict iy,
+                           const S* __restrict iz, S* __restrict m00, S* __restrict m01, S* __restrict m02,
+                           S* __restrict m10, S* __restrict m11, S* __restrict m12, S* __restrict m20,
+                           S* __restrict m21, S* __restrict m22, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        const S w = iw[i], x = ix[i], y = iy[i], z = iz[i];
+        const S s = Normalize ? S(2) / (w * w + x * x + y * y + z * z) : S(2);
+        const S xx = s * x * x, yy = s * y * y, zz = s * z * z;
+        const S xy = s * x * y, xz = s * x * z, yz = s * y * z;
+        const S wx = s * w * x, wy = s * w * y, wz = s * w * z;
+        m00[i] = 1 - yy - zz;
+        m01[i] = xy - wz;
+        m02[i] = xz + wy;
+        m10[i] = xy + wz;
+        m11[i] = 1 - xx - zz;
+        m12[i] = yz - wx;
+        m20[i] = xz - wy;
+        m21[i] = yz + wx;
+        m22[i] = 1 - xx - yy;
+    }
+}
+
+template <typename S>
+void convertBlock(const Quaternions<S>& in, const RotationMatrices<S>& out, size_t n, bool orthonormalize) {
+    S* const* m = out.m;
+    if (orthonormalize) {
+        quaternionsToMatrices<true>(in.w, in.x, in.y, in.z, m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8], n);
+    } else {
+        quaternionsToMatrices<false>(in.w, in.x, in.y, in.z, m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8], n);
+    }
+}
+
+// theta = 2 atan2(|v|, |w|) and the factor theta / |v|, with the sign of
+// the quaternion folded in so that w >= 0
+template <typename S>
+void quaternionAngle(S w, S x, S y, S z, bool normalize, S& theta, S& scale, S& vnorm) {
+    const S k = normalize ? S(1) / std::sqrt(w * w + x * x + y * y + z * z) : S(1);
+    const S aw = k * std::abs(w);
+    const S v2 = k * k * (x * x + y * y + z * z);
+    vnorm = std::sqrt(v2);
+    theta = 2 * std::atan2(vnorm, aw);
+    // theta / |v| = (2 / w) (1 - |v|^2 / (3 w^2) + ...) for small angles
+    const S series = 2 / aw * (1 - v2 / (3 * aw * aw));
+    scale = theta * theta < kLieSmallAngle2<S>() ? series : theta / vnorm;
+    scale = k * (w < 0 ? -scale : scale);
+}
+
+template <typename S>
+void convertBlock(const Quaternions<S>& in, const RotationVectors<S>& out, size_t n, bool orthonormalize) {
+    for (size_t i = 0; i < n; ++i) {
+        S theta, scale, vnorm;
+        quaternionAngle(in.w[i], in.x[i], in.y[i], in.z[i], orthonormalize, theta, scale, vnorm);
+        out.x[i] = scale * in.x[i];
+        out.y[i] = scale * in.y[i];
+        out.z[i] = scale * in.z[i];
+    }
+}
+
+template <typename S>
+void convertBlock(const RotationVectors<S>& in, const Quaternions<S>& out, size_t n, bool) {
+    for (size_t i = 0; i < n; ++i) {
+        const S x = in.x[i], y = in.y[i], z = in.z[i];
+        const S theta2 = x * x + y * y + z * z;
+        const S theta = std::sqrt(theta2);
+        // sin(theta / 2) / theta, cos(theta / 2)
+        const S series = S(0.5) - theta2 / 48;
+        const S k = theta2 < kLieSmallAngle2<S>() ? series : std::sin(S(0.5) * theta) / theta;
+        out.w[i] = std::cos(S(0.5) * theta);
+        out.x[i] = k * x;
+        out.y[i] = k * y;
+        out.z[i] = k * z;
+    }
+}
+
+template <typename S>
+void convertBlock(const Quaternions<S>& in, const AngleAxes<S>& out, size_t n, bool orthonormalize) {
+    for (size_t i = 0; i < n; ++i) {
+        S theta, scale, vnorm;
+        quaternionAngle(in.w[i], in.x[i], in.y[i], in.z[i], orthonormalize, theta, scale, vnorm);
+        // Unit axis v / |v|, or (1, 0, 0) for the identity
+        const bool zero = !(vnorm > 0);
+        const S k = zero ? S(0) : scale / theta;
+        out.angle[i] = theta;
+        out.x[i] = zero ? S(1) : k * in.x[i];
+        out.y[i] = k * in.y[i];
+        out.z[i] = k * in.z[i];
+    }
+}
+
+template <typename S>
+void convertBlock(const AngleAxes<S>& in, const Quaternions<S>& out, size_t n, bool orthonormalize) {
+    for (size_t i = 0; i < n; ++i) {
+        const S x = in.x[i], y = in.y[i], z = in.z[i];
+        const S half = S(0.5) * in.angle[i];
+        S k = std::sin(half);
+        k = orthonormalize ? k / std::sqrt(x * x + y * y + z * z) : k;
+        out.w[i] = std::cos(half);
+        out.x[i] = k * x;
+        out.y[i] = k * y;
+        out.z[i] = k * z;
+    }
+}
+
+template <typename S>
+void convertBlock(const AngleAxes<S>& in, const RotationVectors<S>& out, size_t n, bool orthonormalize) {
+    for (size_t i = 0; i < n; ++i) {
+        const S x = in.x[i], y = in.y[i], z = in.z[i];
+        const S k = orthonormalize ? in.angle[i] / std::sqrt(x * x + y * y + z * z) : in.angle[i];
+        out.x[i] = k * x;
+        out.y[i] = k * y;
+        out.z[i] = k * z;
+    }
+}
+
+template <typename S>
+void convertBlock(const RotationVectors<S>& in, const AngleAxes<S>& out, size_t n, bool) {
+    for (size_t i = 0; i < n; ++i) {
+        const S x = in.x[i], y = in.y[i], z = in.z[i];
+        const S theta = std::sqrt(x * x + y * y + z * z);
+        const bool zero = !(theta > 0);
+        const S k = zero ? S(0) : S(1) / theta;
+        out.angle[i] = theta;
+        out.x[i] = zero ? S(1) : k * x;
+        out.y[i] = k * y;
+        out.z[i] = k * z;
+    }
+}
+
+// Yaw / pitch / roll from the first two rows of R and r20. Roll comes
+// from yaw and the second and third columns, which stay well defined at
+// gimbal lock.
+template <typename S>
+void eulerFromMatrix(S r00, S r01, S r02, S r10, S r11, S r12, S r20, S& yaw, S& pitch, S& roll) {
+    yaw = std::atan2(r10, r00);
+    pitch = std::atan2(-r20, std::sqrt(r00 * r00 + r10 * r10));
+    const S cy = std::cos(yaw), sy = std::sin(yaw);
+    roll = std::atan2(sy * r02 - cy * r12, cy * r11 - sy * r01);
+}
+
+template <typename S>
+void convertBlock(const RotationMatrices<S>& in, const EulerAnglesZYX<S>& out, size_t n, bool orthonormalize) {
+    if (orthonormalize) {
+        convertViaQuaternions(in, out, n, true);
+        return;
+    }
+    const S* const* m = in.m;
+    for (size_t i = 0; i < n; ++i) {
+        eulerFromMatrix(m[0][i], m[1][i], m[2][i], m[3][i], m[4][i], m[5][i], m[6][i], out.yaw[i], out.pitch[i],
+                        out.roll[i]);
+    }
+}
+
+template <typename S>
+void convertBlock(const EulerAnglesZYX<S>& in, const RotationMatrices<S>& out, size_t n, bool) {
+    S* const* m = out.m;
+    for (size_t i = 0; i < n; ++i) {
+        const S cy = std::cos(in.yaw[i]), sy = std::sin(in.yaw[i]);
+        const S cp = std::cos(in.pitch[i]), sp = std::sin(in.pitch[i]);
+        const S cr = std::cos(in.roll[i]), sr = std::sin(in.roll[i]);
+        m[0][i] = cy * cp;
+        m[1][i] = cy * sp * sr - sy * cr;
+        m[2][i] = cy * sp * cr + sy * sr;
+        m[3][i] = sy * cp;
+        m[4][i] = sy * sp * sr + cy * cr;
+        m[5][i] = sy * sp * cr - cy * sr;
+        m[6][i] = -sp;
+        m[7][i] = cp * sr;
+        m[8][i] = cp * cr;
+    }
+}
+
+template <typename S>
+void convertBlock(const Quaternions<S>& in, const EulerAnglesZYX<S>& out, size_t n, bool orthonormalize) {
+    for (size_t i = 0; i < n; ++i) {
+        const S w = in.w[i], x = in.x[i], y = in.y[i], z = in.z[i];
+        const S s = orthonormalize ? S(2) / (w * w + x * x + y * y + z * z) : S(2);
+        const S xx = s * x * x, yy = s * y * y, zz = s * z * z;
+        const S xy = s * x * y, xz = s * x * z, yz = s * y * z;
+        const S wx = s * w * x, wy = s * w * y, wz = s * w * z;
+        eulerFromMatrix(1 - yy - zz, xy - wz, xz + wy, xy + wz, 1 - xx - zz, yz - wx, xz - wy, out.yaw[i],
+                        out.pitch[i], out.roll[i]);
+    }
+}
+
+// q = qz(yaw) qy(pitch) qx(roll)
+template <typename S>
+void convertBlock(const EulerAnglesZYX<S>& in, const Quaternions<S>& out, size_t n, bool) {
+    for (size_t i = 0; i < n; ++i) {
+        const S cy = std::cos(S(0.5) * in.yaw[i]), sy = std::sin(S(0.5) * in.yaw[i]);
+        const S cp = std::cos(S(0.5) * in.pitch[i]), sp = std::sin(S(0.5) * in.pitch[i]);
+        const S cr = std::cos(S(0.5) * in.roll[i]), sr = std::sin(S(0.5) * in.roll[i]);
+        out.w[i] = cr * cp * cy + sr * sp * sy;
+        out.x[i] = sr * cp * cy - cr * sp * sy;
+        out.y[i] = cr * sp * cy + sr * cp * sy;
+        out.z[i] = cr * cp * sy - sr * sp * cy;
+    }
+}
+
+// Every other pair: through quaternions, one stack block at a time
+template <typename From, typename To>
+void convertBlock(const From& in, const To& out, size_t n, bool orthonormalize) {
+    convertViaQuaternions(in, out, n, orthonormalize);
+}
+
+template <typename From, typename To>
+void convertViaQuaternions(const From& in, const To& out, size_t n, bool orthonormalize) {
+    typedef typename To::Scalar S;
+    static_assert(std::is_same<typename From::Scalar, S>::value, "Convert between arrays of one scalar type");
+    S w[kRotationBlock], x[kRotationBlock], y[kRotationBlock], z[kRotationBlock];
+    const Quaternions<S> q{w, x, y, z};
+    for (size_t b = 0; b < n; b += kRotationBlock) {
+        const size_t len = std::min(kRotationBlock, n - b);
+        convertBlock(in.offset(b), q, len, orthonormalize);
+        convertBlock(q, out.offset(b), len, false);
+    }
+}
+
+}  // namespace detail
+
+// out[i] = in[i] in the output representation, for i in [0, n)
+template <typename From, typename To>
+void convertRotations(const From& in, const To& out, size_t n, bool orthonormalize = false) {
+    parallelFor(n, kRotationMinChunk, [&](size_t b, size_t e) {
+        detail::convertBlock(in.offset(b), out.offset(b), e - b, orthonormalize);
+    });
+}
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_ROTATION_BATCH_H
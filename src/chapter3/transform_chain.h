@@ -0,0 +1,158 @@
+/**
+ * Transform chains collapsed into one 3x4 affine (see 3.11)
+ *
+ * 3.9 composes T_world_base * T_base_link1 * ... and applies the links one
+ * at a time. Applying a chain of K links to N points that way costs K
+ * matrix-vector products per point; composing the links first costs K-1
+ * tiny 3x4 products once, then one pass over the points.
+ *
+ *   fuse(T_a, T_b, T_c)            variadic, unrolled at compile time
+ *   FixedTransformChain<S, K>      K known at compile time, product unrolled
+ *   TransformChain<S>              length known at run time, product cached
+ *                                  and recomputed lazily after a link changes
+ *
+ * Both chain types apply the fused transform with transformPoints() from
+ * chapter1/soa_transform.h, i.e. one SIMD pass over an SoA cloud.
+ */
+
+#ifndef EIGEN_TUTORIAL_TRANSFORM_CHAIN_H
+#define EIGEN_TUTORIAL_TRANSFORM_CHAIN_H
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "chapter1/soa_transform.h"
+
+namespace eigen_tutorial {
+
+// Last row of an affine transform is always [0 0 0 1]; AffineCompact drops it
+template <typename Scalar>
+using Affine34 = Eigen::Transform<Scalar, 3, Eigen::AffineCompact>;
+
+// fuse(T1, T2, ..., Tk) = T1 * T2 * ... * Tk as a 3x4 affine
+template <typename Scalar, int Mode, int Options>
+Affine34<Scalar> fuse(const Eigen::Transform<Scalar, 3, Mode, Options>& T) {
+    static_assert(Mode != Eigen::Projective, "Chains must be affine");
+    return Affine34<Scalar>(T);
+}
+
+template <typename Scalar, int Mode, int Options, typename... Rest>
+Affine34<Scalar> fuse(const Eigen::Transform<Scalar, 3, Mode, Options>& first, const Rest&... rest) {
+    static_assert(Mode != Eigen::Projective, "Chains must be affine");
+    return Affine34<Scalar>(first) * fuse(rest...);
+}
+
+namespace detail {
+
+// links[I] * links[I+1] * ... * links[K-1], expanded by the compiler
+template <typename Scalar, int I, int K, bool Last = (I == K - 1)>
+struct ChainProduct {
+    static Affine34<Scalar> run(const Affine34<Scalar>* links) {
+        return links[I] * ChainProduct<Scalar, I + 1, K>::run(links);
+    }
+};
+
+template <typename Scalar, int I, int K>
+struct ChainProduct<Scalar, I, K, true> {
+    static Affine34<Scalar> run(const Affine34<Scalar>* links) { return links[I]; }
+};
+
+}  // namespace detail
+
+// Chain whose length K is a compile-time constant. Links are stored in
+// order from the outermost frame: fused() = links[0] * links[1] * ... * links[K-1].
+template <typename Scalar, int K>
+class FixedTransformChain {
+    static_assert(K >= 1, "A chain needs at least one link");
+
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    FixedTransformChain() {
+        for (int i = 0; i < K; ++i) links_[i].setIdentity();
+    }
+
+    template <int Mode, int Options, typename... Rest>
+    explicit FixedTransformChain(const Eigen::Transform<Scalar, 3, Mode, Options>& first,
+                                 const Rest&... rest) {
+        static_assert(sizeof...(Rest) + 1 == K, "Number of links must match K");
+        setAll(0, first, rest...);
+    }
+
+    static constexpr int size() { return K; }
+
+    template <int Mode, int Options>
+    void setLink(int i, const Eigen::Transform<Scalar, 3, Mode, Options>& T) {
+        assert(i >= 0 && i < K);
+        links_[i] = Affine34<Scalar>(T);
+    }
+    const Affine34<Scalar>& link(int i) const { return links_[i]; }
+
+    Affine34<Scalar> fused() const { return detail::ChainProduct<Scalar, 0, K>::run(links_); }
+
+    template <typename PointScalar>
+    void apply(const PointCloudSoA<PointScalar>& in, PointCloudSoA<PointScalar>& out) const {
+        transformPoints(fused(), in, out);
+    }
+
+private:
+    void setAll(int) {}
+    template <typename First, typename... Rest>
+    void setAll(int i, const First& first, const Rest&... rest) {
+        setLink(i, first);
+        setAll(i + 1, rest...);
+    }
+
+    Affine34<Scalar> links_[K];
+};
+
+// Chain whose length is only known at run time. The fused product is cached
+// and recomputed on the next fused()/apply() after any link changes.
+// Like any lazily cached object, a dirty chain must not be read from
+// several threads at once; call fused() once before sharing it.
+template <typename Scalar>
+class TransformChain {
+public:
+    TransformChain() { fused_.setIdentity(); }
+
+    template <int Mode, int Options>
+    void push_back(const Eigen::Transform<Scalar, 3, Mode, Options>& T) {
+        links_.push_back(Affine34<Scalar>(T));
+        dirty_ = true;
+    }
+
+    template <int Mode, int Options>
+    void setLink(size_t i, const Eigen::Transform<Scalar, 3, Mode, Options>& T) {
+        assert(i < links_.size());
+        links_[i] = Affine34<Scalar>(T);
+        dirty_ = true;
+    }
+    const Affine34<Scalar>& link(size_t i) const { return links_[i]; }
+    size_t size() const { return links_.size(); }
+
+    const Affine34<Scalar>& fused() const {
+        if (dirty_) {
+            fused_.setIdentity();
+            for (const Affine34<Scalar>& T : links_) fused_ = fused_ * T;
+            dirty_ = false;
+        }
+        return fused_;
+    }
+
+    template <typename PointScalar>
+    void apply(const PointCloudSoA<PointScalar>& in, PointCloudSoA<PointScalar>& out) const {
+        transformPoints(fused(), in, out);
+    }
+
+private:
+    std::vector<Affine34<Scalar>, Eigen::aligned_allocator<Affine34<Scalar>>> links_;
+    mutable Affine34<Scalar> fused_;
+    mutable bool dirty_ = false;
+};
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_TRANSFORM_CHAIN_H
@@ -0,0 +1,201 @@
+/**
+ * Transform tree with cached root transforms and seqlock reads (see 3.13)
+ *
+ * 3.8 and 3.9 compose T_world_camera and similar chains by hand at every
+ * use. In a running system the tree is fixed (world -> odom -> base ->
+ * sensors, arm links, ...), a few writers update single links, and many
+ * threads look up frame-to-frame transforms thousands of times per second.
+ *
+ * TransformTree caches T_root_frame for every frame. A lookup is then
+ *
+ *   T_target_source = T_root_target^-1 * T_root_source
+ *
+ * i.e. one rigid inverse and one 3x4 product, whatever the depth. setLink()
+ * recomputes the cached transforms of the changed frame's subtree only:
+ * updating a joint near a leaf touches a handful of frames, updating odom
+ * touches everything below it.
+ *
+ * Concurrency: writers serialize on a mutex; readers never lock. The cached
+ * transforms are guarded by one sequence counter for the whole tree
+ * (seqlock): a writer makes it odd, rewrites its subtree, and makes it even
+ * again; a reader copies what it needs and retries if the counter was odd
+ * or changed meanwhile. One counter, rather than one per frame, is what
+ * keeps the two root transforms of a lookup from different tree states
+ * (e.g. the camera after an odom update and the lidar before it). Retries
+ * only happen while a subtree is being rewritten, which takes well under a
+ * microsecond, and writers never wait for readers. A reader that keeps
+ * failing yields every kSeqlockSpins attempts, in case the writer was
+ * preempted mid-write or shares its core.
+ *
+ * The cached transforms are stored as relaxed atomics so that the racy
+ * copy of a seqlock read is well defined; on x86 and ARM these are plain
+ * loads and stores.
+ *
+ * Capacity is fixed at construction so that frames never move while
+ * readers copy them. Links are assumed rigid (lookups use the isometry
+ * inverse).
+ */
+
+#ifndef EIGEN_TUTORIAL_TRANSFORM_TREE_H
+#define EIGEN_TUTORIAL_TRANSFORM_TREE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "chapter3/transform_chain.h"
+
+namespace eigen_tutorial {
+
+// Seqlock retries between yields to a possibly preempted writer
+const int kSeqlockSpins = 64;
+
+template <typename Scalar>
+class TransformTree {
+public:
+    typedef Affine34<Scalar> Transform;
+
+    // Frame 0 is the root; maxFrames() includes it
+    explicit TransformTree(int max_frames)
+        : max_frames_(max_frames < 1 ? 1 : max_frames),
+          cached_(new CachedTransform[static_cast<size_t>(max_frames_)]),
+          parent_(static_cast<size_t>(max_frames_), -1),
+          children_(static_cast<size_t>(max_frames_)),
+          links_(static_cast<size_t>(max_frames_), Transform::Identity()),
+          roots_(static_cast<size_t>(max_frames_), Transform::Identity()),
+          size_(1) {
+        store(0, Transform::Identity());
+    }
+
+    int maxFrames() const { return max_frames_; }
+    int size() const { return size_.load(std::memory_order_acquire); }
+
+    // Adds a frame below `parent` and returns its id, or -1 if the tree is
+    // full or the parent does not exist
+    template <int Mode, int Options>
+    int addFrame(int parent, const Eigen::Transform<Scalar, 3, Mode, Options>& T_parent_frame) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        const int id = size_.load(std::memory_order_relaxed);
+        if (id >= max_frames_ || parent < 0 || parent >= id) return -1;
+        parent_[id] = parent;
+        children_[parent].push_back(id);
+        links_[id] = Transform(T_parent_frame);
+        roots_[id] = roots_[parent] * links_[id];
+        // Not yet visible to readers: no sequence bump needed
+        store(id, roots_[id]);
+        size_.store(id + 1, std::memory_order_release);
+        return id;
+    }
+
+    int parent(int frame) const { return parent_[frame]; }
+
+    // Replaces T_parent_frame and refreshes the subtree below `frame`.
+    // Returns how many cached transforms were recomputed.
+    template <int Mode, int Options>
+    int setLink(int frame, const Eigen::Transform<Scalar, 3, Mode, Options>& T_parent_frame) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (frame <= 0 || frame >= size_.load(std::memory_order_relaxed)) return 0;
+        links_[frame] = Transform(T_parent_frame);
+
+        // Recompute first, so readers only retry during the stores below
+        stack_.assign(1, frame);
+        dirty_.clear();
+        while (!stack_.empty()) {
+            const int f = stack_.back();
+            stack_.pop_back();
+            roots_[f] = roots_[parent_[f]] * links_[f];
+            dirty_.push_back(f);
+            stack_.insert(stack_.end(), children_[f].begin(), children_[f].end());
+        }
+
+        const uint64_t seq = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (int f : dirty_) store(f, roots_[f]);
+        sequence_.store(seq + 2, std::memory_order_release);
+        return static_cast<int>(dirty_.size());
+    }
+
+    // T_root_frame; `retries` (optional) counts the seqlock retries
+    Transform rootTransform(int frame, int* retries = nullptr) const {
+        Transform T;
+        int attempts = 0;
+        for (;;) {
+            const uint64_t seq = sequence_.load(std::memory_order_acquire);
+            if (!(seq & 1)) {
+                load(frame, T);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence_.load(std::memory_order_relaxed) == seq) break;
+            }
+            // A writer preempted mid-write (or sharing our core) needs the CPU
+            if (++attempts % kSeqlockSpins == 0) std::this_thread::yield();
+        }
+        if (retries) *retries += attempts;
+        return T;
+    }
+
+    // T_target_source: maps points in `source` coordinates to `target`
+    Transform lookup(int target, int source, int* retries = nullptr) const {
+        Transform T_root_target, T_root_source;
+        int attempts = 0;
+        for (;;) {
+            const uint64_t seq = sequence_.load(std::memory_order_acquire);
+            if (!(seq & 1)) {
+                load(target, T_root_target);
+                load(source, T_root_source);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence_.load(std::memory_order_relaxed) == seq) break;
+            }
+            // A writer preempted mid-write (or sharing our core) needs the CPU
+            if (++attempts % kSeqlockSpins == 0) std::this_thread::yield();
+        }
+        if (retries) *retries += attempts;
+        return T_root_target.inverse(Eigen::Isometry) * T_root_source;
+    }
+
+    // Number of completed writes (each setLink adds one)
+    uint64_t version() const { return sequence_.load(std::memory_order_acquire) / 2; }
+
+private:
+    // 3x4 column-major, as Affine34::matrix().data()
+    struct CachedTransform {
+        std::atomic<Scalar> m[12];
+    };
+
+    void store(int frame, const Transform& T) {
+        const Scalar* src = T.matrix().data();
+        std::atomic<Scalar>* dst = cached_[frame].m;
+        for (int i = 0; i < 12; ++i) dst[i].store(src[i], std::memory_order_relaxed);
+    }
+
+    void load(int frame, Transform& T) const {
+        const std::atomic<Scalar>* src = cached_[frame].m;
+        Scalar* dst = T.matrix().data();
+        for (int i = 0; i < 12; ++i) dst[i] = src[i].load(std::memory_order_relaxed);
+    }
+
+    const int max_frames_;
+    std::unique_ptr<CachedTransform[]> cached_;  // Read by everyone
+    std::atomic<uint64_t> sequence_{0};
+
+    // Writer-side state, guarded by write_mutex_
+    std::mutex write_mutex_;
+    std::vector<int> parent_;
+    std::vector<std::vector<int>> children_;
+    std::vector<Transform, Eigen::aligned_allocator<Transform>> links_;
+    std::vector<Transform, Eigen::aligned_allocator<Transform>> roots_;
+    std::vector<int> stack_, dirty_;
+    std::atomic<int> size_;
+};
+
+typedef TransformTree<double> TransformTreed;
+typedef TransformTree<float> TransformTreef;
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_TRANSFORM_TREE_H
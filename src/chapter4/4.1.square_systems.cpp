@@ -2,6 +2,8 @@
  * Chapter 4.1: Square Systems Ax = b
  *
  * Topics: LU, FullPivLU, QR solvers for square matrices
+ *
+ * Millions of small systems at once, one per SIMD lane: 4.10
  */
 
 #include <iostream>
@@ -0,0 +1,127 @@
+/**
+ * Chapter 4.11: Recursive Least Squares
+ *
+ * Topics: Givens updates of a QR factor, hyperbolic downdates, exponential
+ *         forgetting, batched row updates
+ * SLAM Applications: Online calibration (sensor biases, scale, time
+ *                    offsets), sliding-window estimators, drifting parameters
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <Eigen/Dense>
+
+#include "chapter4/recursive_least_squares.h"
+
+namespace {
+
+double usSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Cubic calibration curve b = x0 + x1 t + x2 t^2 + x3 t^3 plus noise, as
+// rows [1 t t^2 t^3]
+struct Stream {
+    std::mt19937 rng{11};
+    std::uniform_real_distribution<double> time{-1, 1};
+    std::normal_distribution<double> noise{0, 0.01};
+
+    void next(const Eigen::Vector4d& x, Eigen::Vector4d& a, double& b) {
+        const double t = time(rng);
+        a << 1, t, t * t, t * t * t;
+        b = a.dot(x) + noise(rng);
+    }
+};
+
+Eigen::VectorXd batchSolve(const Eigen::MatrixXd& A, const Eigen::VectorXd& b) {
+    return A.householderQr().solve(b);
+}
+
+}  // namespace
+
+int main() {
+    std::cout << "=== 4.11 Recursive Least Squares ===\n\n";
+
+    const Eigen::Vector4d x_true(0.5, -1.0, 2.0, 0.3);
+    const int m = 10000;
+    Stream stream;
+    Eigen::MatrixXd A(m, 4);
+    Eigen::VectorXd b(m);
+    for (int i = 0; i < m; ++i) {
+        Eigen::Vector4d a;
+        stream.next(x_true, a, b(i));
+        A.row(i) = a.transpose();
+    }
+
+    // One row at a time vs refactoring everything seen so far
+    eigen_tutorial::RecursiveLeastSquares rls(4);
+    Eigen::VectorXd x;
+    double update_us = 0;
+    for (int i = 0; i < m; ++i) {
+        const auto t0 = std::chrono::steady_clock::now();
+        rls.addRow(A.row(i), b(i));
+        rls.solve(x);
+        update_us += usSince(t0);
+    }
+    const Eigen::VectorXd x_batch = batchSolve(A, b);
+    std::cout << m << " rows, 4 unknowns:\n"
+              << "    |x_rls - x_qr| = " << (x - x_batch).norm() << ", rss " << rls.residualSquaredNorm()
+              << " vs " << (A * x_batch - b).squaredNorm() << "\n";
+    for (int rows : {100, 1000, 10000}) {
+        const auto t0 = std::chrono::steady_clock::now();
+        x = batchSolve(A.topRows(rows), b.head(rows));
+        std::cout << "    refactor " << rows << " rows: " << usSince(t0) << " us per update\n";
+    }
+    std::cout << "    addRow + solve: " << update_us / m << " us per update, whatever the row count\n\n";
+
+    // Batched rows: one Householder QR of [R z; A b]
+    eigen_tutorial::RecursiveLeastSquares batched(4);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < m; i += 1000) batched.addRows(A.middleRows(i, 1000), b.segment(i, 1000));
+    batched.solve(x);
+    std::cout << "addRows, 1000 rows per call: " << usSince(t0) / m << " us per row, |x - x_qr| = "
+              << (x - x_batch).norm() << "\n\n";
+
+    // Sliding window of the last 500 rows: add the new row, remove the
+    // oldest, compare with a fresh QR of the window
+    const int window = 500;
+    eigen_tutorial::RecursiveLeastSquares sliding(4);
+    double worst = 0;
+    int refused = 0;
+    for (int i = 0; i < m; ++i) {
+        sliding.addRow(A.row(i), b(i));
+        if (i >= window) refused += !sliding.removeRow(A.row(i - window), b(i - window));
+        if (i >= window && i % 500 == 0) {
+            sliding.solve(x);
+            worst = std::max(worst, (x - batchSolve(A.middleRows(i - window + 1, window),
+                                                    b.segment(i - window + 1, window))).norm());
+        }
+    }
+    std::cout << "Sliding window of " << window << " rows over " << m << ": max |x - x_qr(window)| = " << worst
+              << ", " << refused << " downdates refused\n";
+    Eigen::Vector4d never_added(1, 10, 100, 1000);
+    std::cout << "Removing a row that was never added: "
+              << (sliding.removeRow(never_added, 0.0) ? "accepted" : "refused") << "\n\n";
+
+    // Drifting parameters: x0 jumps halfway through; forgetting tracks it
+    Eigen::Vector4d x_after = x_true;
+    x_after(0) += 0.2;
+    for (double lambda : {1.0, 0.99}) {
+        eigen_tutorial::RecursiveLeastSquares tracker(4);
+        tracker.setForgetting(lambda);
+        Stream drift;
+        for (int i = 0; i < 2000; ++i) {
+            Eigen::Vector4d a;
+            double bi;
+            drift.next(i < 1000 ? x_true : x_after, a, bi);
+            tracker.addRow(a, bi);
+        }
+        tracker.solve(x);
+        std::cout << "Forgetting " << lambda << ": x0 = " << x(0) << " (true " << x_after(0) << ")\n";
+    }
+
+    return 0;
+}
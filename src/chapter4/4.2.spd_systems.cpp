@@ -3,6 +3,8 @@
  *
  * Topics: LLT (Cholesky), LDLT for SPD matrices
  * SLAM: Covariance matrices, Kalman filter
+ *
+ * Batched LLT / LDLT over many small SPD systems: 4.10
  */
 
 #include <iostream>
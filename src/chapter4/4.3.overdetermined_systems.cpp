@@ -3,6 +3,9 @@
  *
  * Topics: Normal equations, QR, SVD for least squares
  * SLAM: Line fitting, pose estimation, triangulation
+ *
+ * Millions of rows without squaring the condition number (TSQR): 2.17
+ * Adding rows one at a time without refactoring: 4.11
  */
 
 #include <iostream>
@@ -2,6 +2,8 @@
  * Chapter 4.5: Weighted Least Squares
  *
  * Topics: Minimize (Ax - b)^T W (Ax - b), handling outliers
+ *
+ * Weights from robust kernels, iterated over millions of rows: 4.12
  */
 
 #include <iostream>
@@ -27,8 +29,9 @@ int main() {
     Eigen::VectorXd weights(4);
     weights << 1, 1, 1, 0.01;  // Downweight the outlier
 
-    // W is diagonal matrix with weights
-    Eigen::MatrixXd W = weights.asDiagonal();
+    // W is a diagonal matrix with weights. Keep it as a diagonal expression:
+    // a dense MatrixXd W would be m x m
+    auto W = weights.asDiagonal();
 
     // Weighted normal equations
     Eigen::MatrixXd AtWA = A_wls.transpose() * W * A_wls;
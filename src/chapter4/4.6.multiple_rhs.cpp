@@ -2,6 +2,8 @@
  * Chapter 4.6: Multiple Right-Hand Sides
  *
  * Topics: Solving AX = B where B has multiple columns
+ *
+ * Thousands of columns, blocked and threaded (dense and sparse): 4.13
  */
 
 #include <iostream>
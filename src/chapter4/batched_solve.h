@@ -0,0 +1,230 @@
+/**
+ * Batched small dense solvers, one system per SIMD lane (see 4.10)
+ *
+ * 4.1 and 4.2 solve one Matrix3d system at a time. A back-end solves
+ * millions of independent 2x2, 3x3 and 6x6 systems per iteration (landmark
+ * updates, Schur complement block inverses, per-point covariances), and for
+ * sizes that small a single solve is mostly pivot logic, divisions and
+ * latency, with little for SIMD to do inside one matrix.
+ *
+ * Here, as in 2.8, every lane of an Eigen array holds a different system:
+ * a batch of SolveLanes systems is gathered into N*N + N arrays and the
+ * factorization runs once on all of them. N is a template parameter, so
+ * every loop has compile-time bounds and unrolls completely. Three kernels:
+ *
+ *   kCholesky  A = L L^T   SPD only; fails when a pivot is <= 0
+ *   kLdlt      A = L D L^T without pivoting: SPD and quasi-definite
+ *              systems; fails on a zero pivot
+ *   kLu        P A = L U with partial pivoting: any nonsingular system;
+ *              fails on a zero pivot (singular matrix)
+ *
+ * Partial pivoting picks a different row per lane, so row swaps are selects
+ * over the remaining columns, like the column swaps of 2.8. Failures never
+ * branch either: a failing lane continues with a harmless pivot, is flagged,
+ * and gets x = 0. The selects are plain lane loops rather than Eigen's
+ * select(), which Eigen 3.4 evaluates one coefficient at a time (and with
+ * it the rsqrt() or inverse() around it); GCC vectorizes the loops.
+ *
+ * Eigen's LDLT pivots on the diagonal and so tolerates some indefinite
+ * systems that kLdlt does not; for SPD input both agree to rounding.
+ */
+
+#ifndef EIGEN_TUTORIAL_BATCHED_SOLVE_H
+#define EIGEN_TUTORIAL_BATCHED_SOLVE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <Eigen/Dense>
+
+#include "common/parallel.h"
+
+namespace eigen_tutorial {
+
+// One 512-bit register worth of systems per batch
+template <typename Scalar>
+struct SolveLanes {
+    enum { value = 64 / sizeof(Scalar) };
+};
+
+enum class SmallSolver { kCholesky, kLdlt, kLu };
+
+// Below this many batches per thread, threads cost more than they save
+const size_t kSolveMinBatches = 256;
+
+namespace detail {
+
+// a > b ? t : e per lane
+template <typename Lane>
+inline Lane selectGreater(const Lane& a, const Lane& b, const Lane& t, const Lane& e) {
+    Lane r;
+    for (int l = 0; l < Lane::SizeAtCompileTime; ++l) r[l] = a[l] > b[l] ? t[l] : e[l];
+    return r;
+}
+
+// Swaps x and y in the lanes where a > b
+template <typename Lane>
+inline void swapGreater(const Lane& a, const Lane& b, Lane& x, Lane& y) {
+    const Lane t = x;
+    x = selectGreater(a, b, y, t);
+    y = selectGreater(a, b, t, y);
+}
+
+// The kernels factor A and solve for b in place: b becomes x. `ok` is 1 in
+// every lane on entry and 0 in lanes that failed on exit.
+template <int N, typename Lane>
+inline void choleskyKernel(Lane A[N][N], Lane b[N], Lane& ok) {
+    for (int j = 0; j < N; ++j) {
+        Lane d = A[j][j];
+        for (int p = 0; p < j; ++p) d -= A[j][p].square();
+        const Lane zero = Lane::Zero(), one = Lane::Ones();
+        ok = selectGreater(d, zero, ok, zero);
+        // Keep 1 / L_jj on the diagonal
+        const Lane inv = selectGreater(d, zero, d, one).rsqrt();
+        A[j][j] = inv;
+        for (int i = j + 1; i < N; ++i) {
+            Lane s = A[i][j];
+            for (int p = 0; p < j; ++p) s -= A[i][p] * A[j][p];
+            A[i][j] = s * inv;
+        }
+    }
+    // L y = b, then L^T x = y
+    for (int i = 0; i < N; ++i) {
+        for (int p = 0; p < i; ++p) b[i] -= A[i][p] * b[p];
+        b[i] *= A[i][i];
+    }
+    for (int i = N - 1; i >= 0; --i) {
+        for (int p = i + 1; p < N; ++p) b[i] -= A[p][i] * b[p];
+        b[i] *= A[i][i];
+    }
+}
+
+template <int N, typename Lane>
+inline void ldltKernel(Lane A[N][N], Lane b[N], Lane& ok) {
+    Lane inv_d[N];
+    for (int j = 0; j < N; ++j) {
+        // w_p = L_jp d_p, reused by every row below j
+        Lane w[N];
+        Lane d = A[j][j];
+        for (int p = 0; p < j; ++p) {
+            w[p] = A[j][p] * A[p][p];
+            d -= w[p] * A[j][p];
+        }
+        const Lane zero = Lane::Zero(), one = Lane::Ones(), magnitude = d.abs();
+        ok = selectGreater(magnitude, zero, ok, zero);
+        A[j][j] = selectGreater(magnitude, zero, d, one);
+        inv_d[j] = A[j][j].inverse();
+        for (int i = j + 1; i < N; ++i) {
+            Lane s = A[i][j];
+            for (int p = 0; p < j; ++p) s -= A[i][p] * w[p];
+            A[i][j] = s * inv_d[j];
+        }
+    }
+    // L y = b, D z = y, L^T x = z
+    for (int i = 0; i < N; ++i) {
+        for (int p = 0; p < i; ++p) b[i] -= A[i][p] * b[p];
+    }
+    for (int i = 0; i < N; ++i) b[i] *= inv_d[i];
+    for (int i = N - 1; i >= 0; --i) {
+        for (int p = i + 1; p < N; ++p) b[i] -= A[p][i] * b[p];
+    }
+}
+
+template <int N, typename Lane>
+inline void luKernel(Lane A[N][N], Lane b[N], Lane& ok) {
+    for (int j = 0; j < N; ++j) {
+        // Bring the largest |A_ij|, i >= j, to row j lane by lane. Columns
+        // left of j are already eliminated, so only j.. need to move.
+        for (int i = j + 1; i < N; ++i) {
+            const Lane candidate = A[i][j].abs(), pivot = A[j][j].abs();
+            for (int c = j; c < N; ++c) swapGreater(candidate, pivot, A[j][c], A[i][c]);
+            swapGreater(candidate, pivot, b[j], b[i]);
+        }
+        const Lane zero = Lane::Zero(), one = Lane::Ones(), magnitude = A[j][j].abs();
+        ok = selectGreater(magnitude, zero, ok, zero);
+        // Keep 1 / U_jj on the diagonal
+        const Lane inv = selectGreater(magnitude, zero, A[j][j], one).inverse();
+        A[j][j] = inv;
+        for (int i = j + 1; i < N; ++i) {
+            const Lane l = A[i][j] * inv;
+            for (int c = j + 1; c < N; ++c) A[i][c] -= l * A[j][c];
+            b[i] -= l * b[j];
+        }
+    }
+    for (int i = N - 1; i >= 0; --i) {
+        for (int c = i + 1; c < N; ++c) b[i] -= A[i][c] * b[c];
+        b[i] *= A[i][i];
+    }
+}
+
+template <SmallSolver Method, int N, typename Lane>
+inline void solveKernel(Lane A[N][N], Lane b[N], Lane& ok) {
+    switch (Method) {
+        case SmallSolver::kCholesky: choleskyKernel<N>(A, b, ok); break;
+        case SmallSolver::kLdlt: ldltKernel<N>(A, b, ok); break;
+        case SmallSolver::kLu: luKernel<N>(A, b, ok); break;
+    }
+}
+
+template <SmallSolver Method, typename Scalar, int N>
+size_t solveBatched(const Eigen::Matrix<Scalar, N, N>* A, const Eigen::Matrix<Scalar, N, 1>* b, size_t n,
+                    Eigen::Matrix<Scalar, N, 1>* x, uint8_t* ok) {
+    const int L = SolveLanes<Scalar>::value;
+    typedef Eigen::Array<Scalar, L, 1> Lane;
+    const size_t batches = (n + L - 1) / L;
+    const int chunks = chunkCount(batches, kSolveMinBatches);
+    std::vector<size_t> failed(static_cast<size_t>(chunks), 0);
+    forChunks(batches, chunks, [&](int chunk, size_t b0, size_t b1) {
+        Lane a[N][N], y[N], good;
+        for (size_t batch = b0; batch < b1; ++batch) {
+            const size_t base = batch * L;
+            const int count = static_cast<int>(std::min<size_t>(L, n - base));
+            for (int l = 0; l < count; ++l) {
+                for (int i = 0; i < N; ++i) {
+                    for (int j = 0; j < N; ++j) a[i][j][l] = A[base + l](i, j);
+                    y[i][l] = b[base + l](i);
+                }
+            }
+            // A short last batch is padded with identity systems
+            for (int l = count; l < L; ++l) {
+                for (int i = 0; i < N; ++i) {
+                    for (int j = 0; j < N; ++j) a[i][j][l] = Scalar(i == j ? 1 : 0);
+                    y[i][l] = Scalar(0);
+                }
+            }
+            good.setOnes();
+            solveKernel<Method, N>(a, y, good);
+            const Lane zero = Lane::Zero();
+            for (int i = 0; i < N; ++i) y[i] = selectGreater(good, zero, y[i], zero);
+            for (int l = 0; l < count; ++l) {
+                for (int i = 0; i < N; ++i) x[base + l](i) = y[i][l];
+                if (ok) ok[base + l] = good[l] > Scalar(0);
+                failed[chunk] += good[l] == Scalar(0);
+            }
+        }
+    });
+    size_t total = 0;
+    for (size_t f : failed) total += f;
+    return total;
+}
+
+}  // namespace detail
+
+// Solves A[m] x[m] = b[m] for m in [0, n). ok (optional) receives 1 for
+// solved systems and 0 for failed ones, whose x is zero. Returns the
+// number of failures.
+template <typename Scalar, int N>
+size_t batchedSolve(const Eigen::Matrix<Scalar, N, N>* A, const Eigen::Matrix<Scalar, N, 1>* b, size_t n,
+                    Eigen::Matrix<Scalar, N, 1>* x, SmallSolver method, uint8_t* ok = nullptr) {
+    switch (method) {
+        case SmallSolver::kCholesky: return detail::solveBatched<SmallSolver::kCholesky>(A, b, n, x, ok);
+        case SmallSolver::kLdlt: return detail::solveBatched<SmallSolver::kLdlt>(A, b, n, x, ok);
+        case SmallSolver::kLu: return detail::solveBatched<SmallSolver::kLu>(A, b, n, x, ok);
+    }
+    return 0;
+}
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_BATCHED_SOLVE_H
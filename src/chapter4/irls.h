@@ -0,0 +1,189 @@
+/**
+ * Iteratively reweighted least squares without a dense W (see 4.12)
+ *
+ * Written as in the textbook, with W = weights.asDiagonal() stored as a
+ * dense m x m matrix, A^T W A takes O(m^2) memory and O(m^2 k) work for an
+ * m x k problem. Only the k x k normal equations
+ *
+ *   H = A^T W A,   g = A^T W b,   H x = g
+ *
+ * are needed, and with W (block) diagonal they are sums over rows. Each
+ * pass here streams A in blocks of rows, and per block
+ *
+ *   1. computes the residuals r = A x - b at the current x,
+ *   2. whitens them with the fixed weights: sqrt(w_i) r_i for per-row
+ *      weights, U_i r_i for groups of d rows with square-root information
+ *      U_i (U_i^T U_i = Lambda_i, e.g. 2D reprojection or 3D point errors),
+ *   3. turns the whitened norms s_i into robust weights (chapter6/
+ *      robust_kernel.h: Huber, Cauchy),
+ *   4. scales the whitened rows of A and b by sqrt(weight) and adds them
+ *      to H (a symmetric rank update) and g.
+ *
+ * Nothing m-sized is allocated, and a pass is O(m k^2) flops with one read
+ * of A. Chunks of rows go to different threads, each with its own H and g,
+ * summed at the end. solve() starts from the ordinary least-squares
+ * solution (unless given a starting x) and repeats passes until x settles.
+ *
+ * A, b and the weights are referenced, not copied: they must outlive the
+ * problem. The kernel width is in whitened units (sigmas when the weights
+ * are inverse variances).
+ */
+
+#ifndef EIGEN_TUTORIAL_IRLS_H
+#define EIGEN_TUTORIAL_IRLS_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <Eigen/Dense>
+
+#include "chapter6/robust_kernel.h"
+#include "common/parallel.h"
+
+namespace eigen_tutorial {
+
+// Rows per block of a pass (whitened block stays in L1/L2)
+const Eigen::Index kIrlsBlock = 512;
+
+// Below this many rows per thread, threads cost more than they save
+const size_t kIrlsMinChunk = 1 << 15;
+
+struct IrlsOptions {
+    RobustKernel kernel = RobustKernel::kHuber;
+    double width = 1.0;
+    int max_iterations = 50;
+    // Stop when |dx| <= tolerance * (1 + |x|)
+    double tolerance = 1e-10;
+};
+
+struct IrlsSummary {
+    int iterations = 0;
+    bool converged = false;
+    double cost = 0;  // Robust cost at the last reweighting point
+};
+
+class IrlsProblem {
+public:
+    IrlsProblem(const Eigen::MatrixXd& A, const Eigen::VectorXd& b) : A_(A), b_(b) {}
+
+    // Inverse variance per row
+    void setRowWeights(const Eigen::VectorXd& weights) {
+        row_weights_ = &weights;
+        sqrt_information_ = nullptr;
+    }
+
+    // Rows in groups of d = sqrt_information.cols(); rows [i d, (i + 1) d)
+    // of the m x d matrix hold U_i for the rows of group i
+    void setBlockWeights(const Eigen::MatrixXd& sqrt_information) {
+        sqrt_information_ = &sqrt_information;
+        row_weights_ = nullptr;
+    }
+
+    Eigen::Index groupSize() const { return sqrt_information_ ? sqrt_information_->cols() : 1; }
+
+    // One pass at x: H = A^T W A (full), g = A^T W b; returns the robust
+    // cost at x. RobustKernel::kNone uses the fixed weights only.
+    double normalEquations(const Eigen::VectorXd& x, RobustKernel kernel, double width, Eigen::MatrixXd& H,
+                           Eigen::VectorXd& g) const {
+        const Eigen::Index k = A_.cols(), m = A_.rows(), d = groupSize();
+        const int chunks = chunkCount(static_cast<size_t>(m), kIrlsMinChunk);
+        std::vector<Eigen::MatrixXd> Hs(chunks, Eigen::MatrixXd::Zero(k, k));
+        std::vector<Eigen::VectorXd> gs(chunks, Eigen::VectorXd::Zero(k));
+        std::vector<double> costs(chunks, 0.0);
+        forChunks(static_cast<size_t>(m), chunks, [&](int c, size_t begin, size_t end) {
+            Eigen::MatrixXd B;
+            Eigen::VectorXd e, bw;
+            Eigen::ArrayXd s, w;
+            const Eigen::Index step = std::max<Eigen::Index>(1, kIrlsBlock / d) * d;
+            for (Eigen::Index r0 = static_cast<Eigen::Index>(begin); r0 < static_cast<Eigen::Index>(end); r0 += step) {
+                const Eigen::Index rows = std::min<Eigen::Index>(step, static_cast<Eigen::Index>(end) - r0);
+                whiten(r0, rows, x, B, bw, e);
+                // Whitened residual norm per group
+                if (d == 1) {
+                    s = e.array().abs();
+                } else {
+                    s.resize(rows / d);
+                    for (Eigen::Index i = 0; i < s.size(); ++i) s(i) = e.segment(i * d, d).norm();
+                }
+                costs[c] += robustCost(kernel, width, s);
+                if (kernel != RobustKernel::kNone) {
+                    w = robustWeights(kernel, width, s).sqrt();
+                    if (d == 1) {
+                        B = w.matrix().asDiagonal() * B;
+                        bw.array() *= w;
+                    } else {
+                        for (Eigen::Index i = 0; i < s.size(); ++i) {
+                            B.middleRows(i * d, d) *= w(i);
+                            bw.segment(i * d, d) *= w(i);
+                        }
+                    }
+                }
+                Hs[c].selfadjointView<Eigen::Lower>().rankUpdate(B.transpose());
+                gs[c].noalias() += B.transpose() * bw;
+            }
+        }, static_cast<size_t>(d));
+        H = Hs[0];
+        g = gs[0];
+        double cost = costs[0];
+        for (int c = 1; c < chunks; ++c) {
+            H += Hs[c];
+            g += gs[c];
+            cost += costs[c];
+        }
+        H.triangularView<Eigen::StrictlyUpper>() = H.transpose();
+        return cost;
+    }
+
+    // Robust fit; x is the starting point if it has A.cols() entries, else
+    // the least-squares solution is used
+    IrlsSummary solve(Eigen::VectorXd& x, const IrlsOptions& options = IrlsOptions()) const {
+        IrlsSummary summary;
+        Eigen::MatrixXd H;
+        Eigen::VectorXd g;
+        if (x.size() != A_.cols()) {
+            x.setZero(A_.cols());
+            normalEquations(x, RobustKernel::kNone, options.width, H, g);
+            x = H.ldlt().solve(g);
+        }
+        while (summary.iterations < options.max_iterations && !summary.converged) {
+            summary.cost = normalEquations(x, options.kernel, options.width, H, g);
+            const Eigen::VectorXd x_new = H.ldlt().solve(g);
+            summary.converged = (x_new - x).norm() <= options.tolerance * (1 + x.norm());
+            x = x_new;
+            ++summary.iterations;
+        }
+        return summary;
+    }
+
+private:
+    // Rows [r0, r0 + rows) whitened by the fixed weights: B = U A, bw = U b,
+    // e = U (A x - b)
+    void whiten(Eigen::Index r0, Eigen::Index rows, const Eigen::VectorXd& x, Eigen::MatrixXd& B,
+                Eigen::VectorXd& bw, Eigen::VectorXd& e) const {
+        B = A_.middleRows(r0, rows);
+        bw = b_.segment(r0, rows);
+        if (row_weights_) {
+            const Eigen::ArrayXd sw = row_weights_->segment(r0, rows).array().sqrt();
+            B = sw.matrix().asDiagonal() * B;
+            bw.array() *= sw;
+        } else if (sqrt_information_) {
+            const Eigen::Index d = sqrt_information_->cols();
+            for (Eigen::Index i = 0; i < rows; i += d) {
+                const auto U = sqrt_information_->middleRows(r0 + i, d);
+                B.middleRows(i, d) = U * A_.middleRows(r0 + i, d);
+                bw.segment(i, d) = U * b_.segment(r0 + i, d);
+            }
+        }
+        e.noalias() = B * x;
+        e -= bw;
+    }
+
+    const Eigen::MatrixXd& A_;
+    const Eigen::VectorXd& b_;
+    const Eigen::VectorXd* row_weights_ = nullptr;
+    const Eigen::MatrixXd* sqrt_information_ = nullptr;
+};
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_IRLS_H
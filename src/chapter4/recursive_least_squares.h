@@ -0,0 +1,179 @@
+/**
+ * Recursive least squares on a Givens-updated R factor (see 4.11)
+ *
+ * 4.3 solves min |A x - b| from scratch. When rows arrive one at a time
+ * (online calibration, odometry scale, sensor biases) refactoring all m
+ * rows per update costs O(m n^2). With A = Q R, everything the solution
+ * needs is the triangular R, the vector z = Q^T b (its first n entries) and
+ * the residual sum of squares rss, so the object keeps only those:
+ *
+ *   addRow(a, b)      [R; a^T] is triangularized again by n Givens
+ *                     rotations, one per entry of a: O(n^2)
+ *   removeRow(a, b)   hyperbolic rotations undo an earlier addRow (sliding
+ *                     windows): O(n^2)
+ *   addRows(A, b)     many rows at once: Householder QR of [R z; A b]
+ *   setForgetting(l)  every row added scales the old ones by l, i.e. rows
+ *                     of age k carry weight l^k (tracking drifting values)
+ *   solve(x)          back substitution R x = z: O(n^2)
+ *
+ * Unlike recursive least squares on the covariance P = (A^T A)^-1 (the
+ * textbook Kalman-style RLS), this never forms A^T A, so it keeps the
+ * conditioning of 4.3's QR solution rather than its square.
+ *
+ * Downdates are the fragile part: removing a row whose information is not
+ * actually in R (or most of it) would leave an indefinite "R^T R".
+ * removeRow() checks |R^-T a| < 1 first (for the weighted row) and refuses
+ * otherwise. It uses the mixed form of the hyperbolic rotation, which is
+ * stable where the plain form is not. With forgetting, pass the row's
+ * current weight (its weight times l^age).
+ */
+
+#ifndef EIGEN_TUTORIAL_RECURSIVE_LEAST_SQUARES_H
+#define EIGEN_TUTORIAL_RECURSIVE_LEAST_SQUARES_H
+
+#include <algorithm>
+#include <cmath>
+#include <Eigen/Dense>
+
+namespace eigen_tutorial {
+
+class RecursiveLeastSquares {
+public:
+    // Row-major: every rotation walks a row of R
+    typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> MatrixR;
+
+    explicit RecursiveLeastSquares(Eigen::Index n) : forgetting_(1) { reset(n); }
+
+    void reset(Eigen::Index n) {
+        R_.setZero(n, n);
+        z_.setZero(n);
+        row_.resize(n);
+        rss_ = 0;
+        rows_ = 0;
+    }
+
+    // 0 < lambda <= 1; 1 (the default) keeps every row at full weight
+    void setForgetting(double lambda) { forgetting_ = std::min(1.0, std::max(lambda, 0.0)); }
+
+    // One row a^T x ~ b with weight w
+    template <typename Derived>
+    void addRow(const Eigen::MatrixBase<Derived>& a, double b, double w = 1.0) {
+        forget();
+        const double sw = std::sqrt(w);
+        row_ = sw * a.transpose();
+        double beta = sw * b;
+        const Eigen::Index n = size();
+        for (Eigen::Index k = 0; k < n; ++k) {
+            if (row_(k) == 0) continue;
+            const double rho = std::sqrt(R_(k, k) * R_(k, k) + row_(k) * row_(k));
+            const double c = R_(k, k) / rho, s = row_(k) / rho;
+            R_(k, k) = rho;
+            const Eigen::Index m = n - k - 1;
+            rotate(R_.row(k).tail(m), row_.tail(m), c, s);
+            const double zk = z_(k);
+            z_(k) = c * zk + s * beta;
+            beta = c * beta - s * zk;
+        }
+        rss_ += beta * beta;
+        ++rows_;
+    }
+
+    // Removes a row added earlier with (current) weight w. Returns false,
+    // and leaves the state alone, if the row is not in the factor.
+    template <typename Derived>
+    bool removeRow(const Eigen::MatrixBase<Derived>& a, double b, double w = 1.0) {
+        const double sw = std::sqrt(w);
+        row_ = sw * a.transpose();
+        double beta = sw * b;
+        // |R^-T a| < 1 <=> R^T R - a a^T stays positive definite
+        if (!solvable() || R_.triangularView<Eigen::Upper>().transpose().solve(row_).squaredNorm() >=
+                               1 - Eigen::NumTraits<double>::epsilon())
+            return false;
+        const Eigen::Index n = size();
+        for (Eigen::Index k = 0; k < n; ++k) {
+            if (row_(k) == 0) continue;
+            const double rho = std::sqrt((R_(k, k) - row_(k)) * (R_(k, k) + row_(k)));
+            const double c = R_(k, k) / rho, s = row_(k) / rho;
+            R_(k, k) = rho;
+            // Mixed form: R' = c R - s r, then r' = (r - s R') / c
+            const Eigen::Index m = n - k - 1;
+            R_.row(k).tail(m) = c * R_.row(k).tail(m) - s * row_.tail(m).transpose();
+            row_.tail(m) = (row_.tail(m) - s * R_.row(k).tail(m).transpose()) / c;
+            z_(k) = c * z_(k) - s * beta;
+            beta = (beta - s * z_(k)) / c;
+        }
+        rss_ = std::max(0.0, rss_ - beta * beta);
+        --rows_;
+        return true;
+    }
+
+    // Rows A x ~ b at once (forgetting applies once, as to a single row)
+    template <typename DerivedA, typename DerivedB>
+    void addRows(const Eigen::MatrixBase<DerivedA>& A, const Eigen::MatrixBase<DerivedB>& b) {
+        forget();
+        const Eigen::Index n = size(), k = A.rows();
+        // [R z; A b; 0 sqrt(rss)] = Q [R' z'; 0 sqrt(rss')]
+        Eigen::MatrixXd M = Eigen::MatrixXd::Zero(n + k + 1, n + 1);
+        M.topLeftCorner(n, n) = R_.triangularView<Eigen::Upper>();
+        M.col(n).head(n) = z_;
+        M.block(n, 0, k, n) = A;
+        M.col(n).segment(n, k) = b;
+        M(n + k, n) = std::sqrt(rss_);
+        Eigen::HouseholderQR<Eigen::MatrixXd> qr(M);
+        const Eigen::MatrixXd& QR = qr.matrixQR();
+        R_ = QR.topLeftCorner(n, n).triangularView<Eigen::Upper>();
+        z_ = QR.col(n).head(n);
+        rss_ = QR(n, n) * QR(n, n);
+        rows_ += k;
+    }
+
+    // x = R^-1 z; false while the rows seen so far do not determine x
+    bool solve(Eigen::VectorXd& x) const {
+        if (!solvable()) return false;
+        x = R_.triangularView<Eigen::Upper>().solve(z_);
+        return true;
+    }
+
+    Eigen::Index size() const { return R_.cols(); }
+    Eigen::Index rows() const { return rows_; }
+    const MatrixR& matrixR() const { return R_; }
+    const Eigen::VectorXd& vectorZ() const { return z_; }
+    // Weighted |A x - b|^2 at the current solution
+    double residualSquaredNorm() const { return rss_; }
+
+private:
+    // (x, y) <- (c x + s y, c y - s x)
+    template <typename X, typename Y>
+    static void rotate(X&& x, Y&& y, double c, double s) {
+        for (Eigen::Index j = 0; j < x.size(); ++j) {
+            const double xj = x(j), yj = y(j);
+            x(j) = c * xj + s * yj;
+            y(j) = c * yj - s * xj;
+        }
+    }
+
+    void forget() {
+        if (forgetting_ == 1) return;
+        const double s = std::sqrt(forgetting_);
+        R_.triangularView<Eigen::Upper>() *= s;
+        z_ *= s;
+        rss_ *= forgetting_;
+    }
+
+    bool solvable() const {
+        if (size() == 0) return true;
+        return R_.diagonal().cwiseAbs().minCoeff() >
+               Eigen::NumTraits<double>::epsilon() * R_.diagonal().cwiseAbs().maxCoeff();
+    }
+
+    MatrixR R_;            // Upper triangular
+    Eigen::VectorXd z_;    // First n entries of Q^T b
+    Eigen::VectorXd row_;  // Scratch for the row being rotated in or out
+    double rss_;
+    Eigen::Index rows_;
+    double forgetting_;
+};
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_RECURSIVE_LEAST_SQUARES_H
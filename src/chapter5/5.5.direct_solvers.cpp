@@ -2,6 +2,8 @@
  * Chapter 5.5: Direct Sparse Solvers
  *
  * Topics: SimplicialLLT, SimplicialLDLT, SparseLU
+ *
+ * One SimplicialLDLT factor, hundreds of right-hand sides: 4.13
  */
 
 #include <iostream>
@@ -0,0 +1,137 @@
+/**
+ * Chapter 6.10: Frustum Culling Against Many Keyframes
+ *
+ * Topics: Division-free pinhole bounds tests, visibility bitsets, coarse
+ *         grid pre-filtering, parallelism over keyframes
+ * SLAM Applications: Covisibility graphs, keyframe selection, choosing the
+ *                    landmarks to project for tracking and BA
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "chapter6/frustum_culling.h"
+
+namespace {
+
+typedef std::vector<Eigen::Isometry3d, Eigen::aligned_allocator<Eigen::Isometry3d>> Poses;
+
+double msSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// T_camera_world of keyframes along a loop through the map, looking
+// forward (camera z) and level (camera y down)
+Poses keyframes(int count, double extent) {
+    Poses poses;
+    for (int k = 0; k < count; ++k) {
+        const double a = 2 * M_PI * k / count;
+        const Eigen::Vector3d position(extent / 2 + 0.4 * extent * std::cos(a), extent / 2 + 0.4 * extent * std::sin(a),
+                                       1.5);
+        const Eigen::Vector3d forward(-std::sin(a + 0.3), std::cos(a + 0.3), 0);
+        Eigen::Matrix3d R_world_camera;
+        R_world_camera.col(2) = forward;
+        R_world_camera.col(1) = -Eigen::Vector3d::UnitZ();
+        R_world_camera.col(0) = R_world_camera.col(1).cross(forward);
+        Eigen::Isometry3d T_world_camera = Eigen::Isometry3d::Identity();
+        T_world_camera.linear() = R_world_camera;
+        T_world_camera.translation() = position;
+        poses.push_back(T_world_camera.inverse());
+    }
+    return poses;
+}
+
+// One point at a time: T * p, then project as in 6.7
+std::vector<uint32_t> referenceVisible(const Eigen::Isometry3d& T_camera_world, const eigen_tutorial::PinholeCamera& cam,
+                                       const std::vector<Eigen::Vector3d>& landmarks) {
+    std::vector<uint32_t> visible;
+    for (size_t i = 0; i < landmarks.size(); ++i) {
+        const Eigen::Vector3d p = T_camera_world * landmarks[i];
+        if (p.z() < cam.min_depth || p.z() > cam.max_depth) continue;
+        const double u = cam.fx * p.x() / p.z() + cam.cx;
+        const double v = cam.fy * p.y() / p.z() + cam.cy;
+        if (u >= 0 && u < cam.width && v >= 0 && v < cam.height) visible.push_back(static_cast<uint32_t>(i));
+    }
+    return visible;
+}
+
+}  // namespace
+
+int main() {
+    std::cout << "=== 6.10 Frustum Culling Against Many Keyframes ===\n\n";
+
+    // 1M landmarks over a 1 km x 1 km map, 100 keyframes seeing up to 60 m
+    const size_t n = 1000000;
+    const double extent = 1000;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> ground(0, extent), height(0, 20);
+    std::vector<Eigen::Vector3d> landmarks(n);
+    eigen_tutorial::PointCloudSoA<double> cloud(n);
+    for (size_t i = 0; i < n; ++i) {
+        landmarks[i] = Eigen::Vector3d(ground(rng), ground(rng), height(rng));
+        cloud.setPoint(i, landmarks[i]);
+    }
+    const eigen_tutorial::PinholeCamera camera{500, 500, 320, 240, 640, 480, 0.5, 60};
+    const Poses poses = keyframes(100, extent);
+    std::cout << n << " landmarks, " << poses.size() << " keyframes, " << camera.width << "x" << camera.height
+              << " pinhole, depth [" << camera.min_depth << ", " << camera.max_depth << "] m\n\n";
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::vector<uint32_t>> reference;
+    for (const Eigen::Isometry3d& T : poses) reference.push_back(referenceVisible(T, camera, landmarks));
+    const double reference_ms = msSince(t0);
+
+    // Without the grid every keyframe scans every landmark; with it only the
+    // cells whose bounding sphere touches the frustum
+    for (double cell_size : {0.0, 10.0, 25.0}) {
+        eigen_tutorial::FrustumCullerd culler;
+        t0 = std::chrono::steady_clock::now();
+        culler.setLandmarks(cloud, cell_size);
+        const double build_ms = msSince(t0);
+
+        eigen_tutorial::FrustumCullerd::Bitset bits;
+        std::vector<uint32_t> indices;
+        t0 = std::chrono::steady_clock::now();
+        size_t visible = 0;
+        for (const Eigen::Isometry3d& T : poses) visible += culler.visible(T, camera, bits);
+        const double serial_ms = msSince(t0);
+
+        std::vector<eigen_tutorial::FrustumCullerd::Bitset> batch;
+        t0 = std::chrono::steady_clock::now();
+        culler.visibleBatch(poses, camera, batch);
+        const double batch_ms = msSince(t0);
+
+        size_t mismatches = 0;
+        for (size_t k = 0; k < poses.size(); ++k) {
+            culler.visibleIndices(poses[k], camera, indices);
+            std::sort(indices.begin(), indices.end());
+            mismatches += indices != reference[k];
+            mismatches += eigen_tutorial::FrustumCullerd::count(batch[k]) != reference[k].size();
+        }
+
+        std::cout << "cell size " << cell_size << " m: " << culler.cellCount() << " cells, "
+                  << culler.size() - n << " padding landmarks, built in " << build_ms << " ms\n"
+                  << "    " << poses.size() << " keyframes: " << serial_ms << " ms serial, " << batch_ms << " ms batch ("
+                  << eigen_tutorial::numThreads() << " threads), " << visible / poses.size()
+                  << " visible per keyframe, " << mismatches << " mismatches vs reference\n";
+    }
+    std::cout << "reference (T * p and project, per landmark): " << reference_ms << " ms\n\n";
+
+    // Covisibility between neighbouring keyframes: AND + popcount
+    eigen_tutorial::FrustumCullerd culler;
+    culler.setLandmarks(cloud, 25.0);
+    std::vector<eigen_tutorial::FrustumCullerd::Bitset> bits;
+    culler.visibleBatch(poses, camera, bits);
+    std::cout << "Bitset per keyframe: " << culler.words() * 8 / 1024.0 << " KB\n"
+              << "Covisible landmarks with keyframe 0:";
+    for (size_t k = 1; k <= 4; ++k) std::cout << " kf" << k << "=" << culler.covisible(bits[0], bits[k]);
+    std::cout << "\n";
+
+    return 0;
+}
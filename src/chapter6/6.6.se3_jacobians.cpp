@@ -3,20 +3,15 @@
  *
  * Topics: Jacobians for pose transformations
  * SLAM: Essential for pose optimization
+ *
+ * SE(3) exp / log, adjoint and left / right Jacobians: 3.12
  */
 
 #include <iostream>
 #include <Eigen/Dense>
 #include <Eigen/Geometry>
 
-// Skew-symmetric matrix
-Eigen::Matrix3d skew(const Eigen::Vector3d& v) {
-    Eigen::Matrix3d m;
-    m <<     0, -v.z(),  v.y(),
-         v.z(),      0, -v.x(),
-        -v.y(),  v.x(),      0;
-    return m;
-}
+#include "chapter3/lie_group.h"
 
 int main() {
     std::cout << "=== 6.6 SE(3) Jacobians ===\n\n";
@@ -41,7 +36,7 @@ int main() {
     // Jacobian of transformation w.r.t. pose (3x6)
     Eigen::Matrix<double, 3, 6> J_pose;
     J_pose.block<3, 3>(0, 0) = Eigen::Matrix3d::Identity();  // d(p')/dt
-    J_pose.block<3, 3>(0, 3) = -R * skew(p);         // d(p')/dw
+    J_pose.block<3, 3>(0, 3) = -R * eigen_tutorial::skew(p);         // d(p')/dw
 
     std::cout << "Jacobian d(p')/d(pose) [3x6]:\n" << J_pose << "\n\n";
 
@@ -2,20 +2,15 @@
  * Chapter 6.7: Reprojection Error Jacobian
  *
  * Topics: Jacobians for visual SLAM optimization
+ *
+ * The same projection as a bulk visibility test over whole maps: 6.10
  */
 
 #include <iostream>
 #include <Eigen/Dense>
 #include <Eigen/Geometry>
 
-// Skew-symmetric matrix
-Eigen::Matrix3d skew(const Eigen::Vector3d& v) {
-    Eigen::Matrix3d m;
-    m <<     0, -v.z(),  v.y(),
-         v.z(),      0, -v.x(),
-        -v.y(),  v.x(),      0;
-    return m;
-}
+#include "chapter3/lie_group.h"
 
 int main() {
     std::cout << "=== 6.7 Reprojection Error Jacobian ===\n\n";
@@ -59,7 +54,7 @@ int main() {
     // Jacobian of transformation w.r.t. pose (3x6)
     Eigen::Matrix<double, 3, 6> J_pose;
     J_pose.block<3, 3>(0, 0) = Eigen::Matrix3d::Identity();
-    J_pose.block<3, 3>(0, 3) = -R_cam * skew(P_world);
+    J_pose.block<3, 3>(0, 3) = -R_cam * eigen_tutorial::skew(P_world);
 
     // Jacobian of reprojection error w.r.t. pose (2x6)
     Eigen::Matrix<double, 2, 6> J_reproj_pose = J_proj * J_pose;
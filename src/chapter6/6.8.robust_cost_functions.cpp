@@ -2,6 +2,8 @@
  * Chapter 6.8: Robust Cost Functions
  *
  * Topics: Huber, Cauchy kernels for handling outliers
+ *
+ * Vectorized kernels and IRLS weights (robust_kernel.h): 4.12
  */
 
 #include <iostream>
@@ -0,0 +1,276 @@
+/**
+ * Frustum culling of landmarks against many keyframes (see 6.10)
+ *
+ * Covisibility graphs, keyframe selection and "which landmarks could this
+ * keyframe see" queries all start from the same step: transform every
+ * landmark into the camera and keep those that project into the image with
+ * the pinhole model of 6.7,
+ *
+ *   Z in [min_depth, max_depth],  u = fx * X / Z + cx in [0, width),
+ *                                 v = fy * Y / Z + cy in [0, height)
+ *
+ * For Z > 0 the image bounds need no division:
+ *
+ *   -cx * Z <= fx * X < (width - cx) * Z     (same for Y with fy, cy)
+ *
+ * so the whole test is the SoA transform of 1.8 followed by six compares
+ * per point, all of which vectorize. The results are packed 64 landmarks
+ * per uint64_t word: a keyframe's visibility of a million landmarks is
+ * 125 KB, and the covisibility of two keyframes is popcount(a & b) over
+ * those words.
+ *
+ * With a cell size, setLandmarks() also builds a coarse grid: landmarks
+ * are sorted by cell (Morton order, see common/voxel_hash.h) and every cell
+ * keeps a bounding sphere. Per keyframe a cell whose sphere is outside one
+ * of the six frustum planes is skipped without touching its points, which
+ * for a large map and a limited max_depth is nearly all of them. Each cell
+ * is padded to a multiple of 64 landmarks with NaN points (which fail every
+ * compare), so cells start on word boundaries.
+ *
+ * Bits follow the culler's internal order (the input order without a grid,
+ * cell order with one); the order is the same for every keyframe, so bitsets
+ * can be combined directly, and originalIndex() maps bit i back to the
+ * input index. visibleIndices() returns input indices.
+ *
+ * visibleBatch() runs keyframes in parallel, one bitset per keyframe.
+ */
+
+#ifndef EIGEN_TUTORIAL_FRUSTUM_CULLING_H
+#define EIGEN_TUTORIAL_FRUSTUM_CULLING_H
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "chapter1/soa_transform.h"
+#include "common/parallel.h"
+#include "common/voxel_hash.h"
+
+namespace eigen_tutorial {
+
+// Landmarks per bitset word
+const size_t kCullWord = 64;
+
+// Input index of padding landmarks
+const uint32_t kNoLandmark = 0xffffffffu;
+
+struct PinholeCamera {
+    double fx, fy, cx, cy;
+    int width, height;
+    double min_depth, max_depth;
+};
+
+namespace detail {
+
+// Per-keyframe constants of the point test
+template <typename Scalar>
+struct FrustumTest {
+    Scalar m[12];  // Row-major [R | t] of T_camera_world
+    Scalar fx, fy, u_min, u_max, v_min, v_max, min_depth, max_depth;
+};
+
+// Eight 0/1 bytes -> eight bits, byte k to bit k (little-endian)
+inline uint64_t packBytes(const uint8_t* bytes) {
+    uint64_t b;
+    std::memcpy(&b, bytes, 8);
+    return (b * 0x0102040810204080ull) >> 56;
+}
+
+// Visibility of landmarks [0, 64) of x, y, z as one word
+template <typename Scalar>
+inline uint64_t frustumWord(const FrustumTest<Scalar>& f, const Scalar* x, const Scalar* y, const Scalar* z) {
+    EIGEN_ALIGN_MAX Scalar cx[kCullWord], cy[kCullWord], cz[kCullWord];
+    transformRange(f.m, x, y, z, cx, cy, cz, 0, kCullWord);
+    // 0/1 flags in Scalar: compares and selects of one width vectorize on
+    // every ISA (SSE2 has no 64-bit integer compares)
+    const Scalar fx = f.fx, fy = f.fy, u_min = f.u_min, u_max = f.u_max, v_min = f.v_min, v_max = f.v_max;
+    const Scalar min_depth = f.min_depth, max_depth = f.max_depth;
+    Scalar flag[kCullWord];
+    for (size_t i = 0; i < kCullWord; ++i) {
+        const Scalar u = fx * cx[i], v = fy * cy[i], d = cz[i];
+        Scalar in = d >= min_depth ? Scalar(1) : Scalar(0);
+        in = d <= max_depth ? in : Scalar(0);
+        in = u >= u_min * d ? in : Scalar(0);
+        in = u < u_max * d ? in : Scalar(0);
+        in = v >= v_min * d ? in : Scalar(0);
+        in = v < v_max * d ? in : Scalar(0);
+        flag[i] = in;
+    }
+    uint8_t inside[kCullWord];
+    for (size_t i = 0; i < kCullWord; ++i) inside[i] = static_cast<uint8_t>(flag[i]);
+    uint64_t word = 0;
+    for (size_t k = 0; k < kCullWord / 8; ++k) word |= packBytes(inside + 8 * k) << (8 * k);
+    return word;
+}
+
+}  // namespace detail
+
+template <typename Scalar>
+class FrustumCuller {
+public:
+    typedef std::vector<uint64_t> Bitset;
+    typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+
+    // cell_size <= 0: no grid, every keyframe tests every landmark
+    void setLandmarks(const PointCloudSoA<Scalar>& landmarks, Scalar cell_size = 0) {
+        const size_t n = static_cast<size_t>(landmarks.size());
+        std::vector<std::pair<uint64_t, uint32_t>> order(n);
+        const Scalar inv_size = cell_size > 0 ? 1 / cell_size : 0;
+        for (size_t i = 0; i < n; ++i)
+            order[i] = std::make_pair(cell_size > 0 ? mortonCode(voxelOf(landmarks.point(i), inv_size)) : 0,
+                                      static_cast<uint32_t>(i));
+        if (cell_size > 0) std::sort(order.begin(), order.end());
+
+        cells_.clear();
+        index_.clear();
+        for (size_t i = 0; i < n;) {
+            // Morton codes only use 21 bits per axis, so two far apart
+            // voxels can share a cell; the sphere below still bounds both
+            size_t j = i;
+            while (j < n && order[j].first == order[i].first) ++j;
+            Cell cell;
+            cell.begin = index_.size();
+            Vector3 lo = landmarks.point(order[i].second), hi = lo;
+            for (size_t k = i; k < j; ++k) {
+                const Vector3 p = landmarks.point(order[k].second);
+                lo = lo.cwiseMin(p);
+                hi = hi.cwiseMax(p);
+                index_.push_back(order[k].second);
+            }
+            index_.resize((index_.size() + kCullWord - 1) / kCullWord * kCullWord, kNoLandmark);
+            cell.end = index_.size();
+            cell.center = (lo + hi) / 2;
+            cell.radius = (hi - lo).norm() / 2;
+            cells_.push_back(cell);
+            i = j;
+        }
+
+        x_.resize(index_.size());
+        y_.resize(index_.size());
+        z_.resize(index_.size());
+        const Scalar nan = std::numeric_limits<Scalar>::quiet_NaN();
+        for (size_t i = 0; i < index_.size(); ++i) {
+            const bool real = index_[i] != kNoLandmark;
+            x_[i] = real ? landmarks.x[index_[i]] : nan;
+            y_[i] = real ? landmarks.y[index_[i]] : nan;
+            z_[i] = real ? landmarks.z[index_[i]] : nan;
+        }
+    }
+
+    // Bits per keyframe (landmarks plus padding)
+    size_t size() const { return index_.size(); }
+    size_t words() const { return index_.size() / kCullWord; }
+    size_t cellCount() const { return cells_.size(); }
+
+    // Input index of bit i, or kNoLandmark for padding
+    uint32_t originalIndex(size_t i) const { return index_[i]; }
+
+    // Visibility from a camera at T_camera_world; returns the visible count
+    template <int Mode, int Options>
+    size_t visible(const Eigen::Transform<double, 3, Mode, Options>& T_camera_world, const PinholeCamera& camera,
+                   Bitset& bits) const {
+        bits.assign(words(), 0);
+        cull(Eigen::Isometry3d(T_camera_world.matrix()), camera, bits.data());
+        return count(bits);
+    }
+
+    // Input indices of the visible landmarks, ascending in internal order
+    template <int Mode, int Options>
+    size_t visibleIndices(const Eigen::Transform<double, 3, Mode, Options>& T_camera_world,
+                          const PinholeCamera& camera, std::vector<uint32_t>& indices) const {
+        Bitset bits;
+        visible(T_camera_world, camera, bits);
+        indices.clear();
+        for (size_t w = 0; w < bits.size(); ++w) {
+            if (!bits[w]) continue;
+            for (size_t i = 0; i < kCullWord; ++i)
+                if ((bits[w] >> i) & 1) indices.push_back(index_[w * kCullWord + i]);
+        }
+        return indices.size();
+    }
+
+    // One bitset per keyframe, keyframes spread over the threads
+    void visibleBatch(const std::vector<Eigen::Isometry3d, Eigen::aligned_allocator<Eigen::Isometry3d>>& T_camera_world,
+                      const PinholeCamera& camera, std::vector<Bitset>& bits) const {
+        bits.resize(T_camera_world.size());
+        parallelFor(T_camera_world.size(), 1, [&](size_t b, size_t e) {
+            for (size_t k = b; k < e; ++k) {
+                bits[k].assign(words(), 0);
+                cull(T_camera_world[k], camera, bits[k].data());
+            }
+        });
+    }
+
+    static size_t count(const Bitset& bits) {
+        size_t c = 0;
+        for (uint64_t w : bits) c += std::bitset<64>(w).count();
+        return c;
+    }
+
+    // Landmarks visible in both keyframes
+    static size_t covisible(const Bitset& a, const Bitset& b) {
+        size_t c = 0;
+        for (size_t w = 0; w < a.size() && w < b.size(); ++w) c += std::bitset<64>(a[w] & b[w]).count();
+        return c;
+    }
+
+private:
+    struct Cell {
+        size_t begin, end;  // Word-aligned range in internal order
+        Vector3 center;
+        Scalar radius;
+    };
+
+    void cull(const Eigen::Isometry3d& T, const PinholeCamera& camera, uint64_t* bits) const {
+        detail::FrustumTest<Scalar> f;
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) f.m[4 * r + c] = static_cast<Scalar>(T.linear()(r, c));
+            f.m[4 * r + 3] = static_cast<Scalar>(T.translation()(r));
+        }
+        f.fx = static_cast<Scalar>(camera.fx);
+        f.fy = static_cast<Scalar>(camera.fy);
+        f.u_min = static_cast<Scalar>(-camera.cx);
+        f.u_max = static_cast<Scalar>(camera.width - camera.cx);
+        f.v_min = static_cast<Scalar>(-camera.cy);
+        f.v_max = static_cast<Scalar>(camera.height - camera.cy);
+        f.min_depth = static_cast<Scalar>(camera.min_depth);
+        f.max_depth = static_cast<Scalar>(camera.max_depth);
+
+        // Inward unit normals of the four side planes (through the camera
+        // center), e.g. fx * X - u_min * Z >= 0 for the left one
+        Eigen::Matrix<double, 4, 3> planes;
+        planes << camera.fx, 0, camera.cx, -camera.fx, 0, camera.width - camera.cx, 0, camera.fy, camera.cy, 0,
+            -camera.fy, camera.height - camera.cy;
+        planes.rowwise().normalize();
+
+        for (const Cell& cell : cells_) {
+            if (cells_.size() > 1) {
+                const Eigen::Vector3d c = T * cell.center.template cast<double>();
+                const double r = cell.radius;
+                if (c.z() < camera.min_depth - r || c.z() > camera.max_depth + r ||
+                    ((planes * c).array() < -r).any())
+                    continue;
+            }
+            for (size_t i = cell.begin; i < cell.end; i += kCullWord)
+                bits[i / kCullWord] = detail::frustumWord(f, x_.data() + i, y_.data() + i, z_.data() + i);
+        }
+    }
+
+    std::vector<Cell> cells_;
+    std::vector<uint32_t> index_;
+    typename PointCloudSoA<Scalar>::Buffer x_, y_, z_;
+};
+
+typedef FrustumCuller<double> FrustumCullerd;
+typedef FrustumCuller<float> FrustumCullerf;
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_FRUSTUM_CULLING_H
@@ -0,0 +1,60 @@
+/**
+ * Robust kernels on arrays of residual norms (see 6.8 and 4.12)
+ *
+ * 6.8 tabulates the Huber and Cauchy costs one residual at a time. Solvers
+ * need them for millions of residuals per iteration, and iteratively
+ * reweighted least squares needs the weight w(s) = rho'(s) / s rather than
+ * rho itself: minimizing sum rho(s_i) is a fixed point of weighted least
+ * squares with weights w(s_i). Both are written as Eigen array expressions
+ * without branches, so they vectorize:
+ *
+ *   Huber(d):   rho = s^2 / 2 (s <= d), d (s - d / 2) otherwise
+ *               w   = min(1, d / s)
+ *               with a = min(s, d):  rho = a (s - a / 2)
+ *   Cauchy(c):  rho = c^2 / 2 log(1 + (s / c)^2)
+ *               w   = 1 / (1 + (s / c)^2)
+ *
+ * s >= 0 is a residual norm (|r| for scalar residuals, the whitened norm
+ * for vector ones) and `width` is d or c in the same units.
+ */
+
+#ifndef EIGEN_TUTORIAL_ROBUST_KERNEL_H
+#define EIGEN_TUTORIAL_ROBUST_KERNEL_H
+
+#include <Eigen/Dense>
+
+namespace eigen_tutorial {
+
+enum class RobustKernel { kNone, kHuber, kCauchy };
+
+// w(s) = rho'(s) / s per entry of s
+template <typename Derived>
+Eigen::Array<typename Derived::Scalar, Eigen::Dynamic, 1> robustWeights(RobustKernel kernel, double width,
+                                                                          const Eigen::ArrayBase<Derived>& s) {
+    typedef typename Derived::Scalar Scalar;
+    const Scalar k = static_cast<Scalar>(width);
+    switch (kernel) {
+        case RobustKernel::kHuber: return (k / s).min(Scalar(1));
+        case RobustKernel::kCauchy: return ((s / k).square() + Scalar(1)).inverse();
+        default: return Eigen::Array<Scalar, Eigen::Dynamic, 1>::Ones(s.size());
+    }
+}
+
+// sum of rho(s)
+template <typename Derived>
+typename Derived::Scalar robustCost(RobustKernel kernel, double width, const Eigen::ArrayBase<Derived>& s) {
+    typedef typename Derived::Scalar Scalar;
+    const Scalar k = static_cast<Scalar>(width);
+    switch (kernel) {
+        case RobustKernel::kHuber: {
+            const Eigen::Array<Scalar, Eigen::Dynamic, 1> a = s.min(k);
+            return (a * (s - Scalar(0.5) * a)).sum();
+        }
+        case RobustKernel::kCauchy: return Scalar(0.5) * k * k * (s / k).square().log1p().sum();
+        default: return Scalar(0.5) * s.square().sum();
+    }
+}
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_ROBUST_KERNEL_H
@@ -0,0 +1,153 @@
+/**
+ * Chapter 7.10: Memory-Mapped Trajectories
+ *
+ * Topics: Quaternion + translation SoA storage, float vs double, mmap-backed
+ *         append-only files, threaded bulk conversion to / from Isometry3d
+ * SLAM Applications: Multi-day pose logs, sharing a live trajectory between
+ *                    the tracker and mapping / visualization processes
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include <unistd.h>
+
+#include "chapter7/mapped_trajectory.h"
+
+namespace {
+
+typedef std::vector<Eigen::Isometry3d, Eigen::aligned_allocator<Eigen::Isometry3d>> IsometryVector;
+
+double msSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Odometry-style trajectory, as in 7.9
+IsometryVector driveTrajectory(size_t n) {
+    IsometryVector poses(n);
+    Eigen::Isometry3d T = Eigen::Isometry3d::Identity();
+    for (size_t i = 0; i < n; ++i) {
+        Eigen::Isometry3d delta = Eigen::Isometry3d::Identity();
+        delta.translation() = Eigen::Vector3d(0.1, 0, 0.001 * std::sin(1e-3 * i));
+        delta.rotate(Eigen::AngleAxisd(0.002 * std::cos(1e-4 * i), Eigen::Vector3d(0.05, 0.1, 1).normalized()));
+        T = T * delta;
+        poses[i] = T;
+    }
+    return poses;
+}
+
+double maxError(const IsometryVector& a, const IsometryVector& b) {
+    double e = 0;
+    for (size_t i = 0; i < a.size(); ++i) e = std::max(e, (a[i].matrix() - b[i].matrix()).cwiseAbs().maxCoeff());
+    return e;
+}
+
+std::string tempPath() {
+    char path[] = "/tmp/eigen_tutorial_trajectoryXXXXXX";
+    const int fd = mkstemp(path);
+    if (fd < 0) return std::string();
+    ::close(fd);
+    return path;
+}
+
+}  // namespace
+
+int main() {
+    std::cout << "=== 7.10 Memory-Mapped Trajectories ===\n\n";
+
+    const size_t n = 1000000;
+    const IsometryVector poses = driveTrajectory(n);
+    std::vector<double> stamps(n);
+    for (size_t i = 0; i < n; ++i) stamps[i] = 1e-2 * i;
+
+    std::cout << "Bytes per pose: Isometry3d " << sizeof(Eigen::Isometry3d) << ", stored double "
+              << 7 * sizeof(double) << " (+8 with timestamp), float " << 7 * sizeof(float) << "\n\n";
+
+    const std::string path = tempPath();
+    if (path.empty()) {
+        std::cout << "No temporary file available\n";
+        return 0;
+    }
+
+    // Bulk append and bulk read, double storage with timestamps
+    eigen_tutorial::MappedTrajectoryd log;
+    if (!log.create(path, true)) {
+        std::cout << "Could not create " << path << "\n";
+        return 0;
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    log.append(poses.data(), n, stamps.data());
+    std::cout << "Bulk append of " << log.size() << " poses: " << msSince(t0) << " ms\n";
+
+    IsometryVector back(n);
+    std::vector<double> back_stamps(n);
+    t0 = std::chrono::steady_clock::now();
+    log.read(0, n, back.data(), back_stamps.data());
+    std::cout << "Bulk read back to Isometry3d: " << msSince(t0) << " ms, max |error| = " << maxError(poses, back)
+              << ", stamp of pose 12345 = " << back_stamps[12345] << "\n";
+
+    // The same, one pose at a time through Eigen's own conversions
+    t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; ++i) {
+        back[i].linear() = log.quaternion(i).normalized().toRotationMatrix();
+        back[i].translation() = log.translation(i);
+    }
+    std::cout << "Pose-by-pose read: " << msSince(t0) << " ms\n\n";
+    log.close();
+
+    // Float storage: half the bytes, ~1e-7 relative error (the translations
+    // of a long drive lose absolute precision with their magnitude)
+    eigen_tutorial::MappedTrajectoryf compact;
+    compact.create(path + ".f", false);
+    compact.append(poses.data(), n);
+    compact.read(0, n, back.data());
+    std::cout << "float storage: max |error| = " << maxError(poses, back) << " (translations up to "
+              << poses.back().translation().norm() << " m)\n\n";
+    compact.close();
+    ::unlink((path + ".f").c_str());
+
+    // A reader with its own mapping (a separate process works the same way)
+    // follows the appender: it only ever sees completely written poses
+    eigen_tutorial::MappedTrajectoryd live;
+    if (!live.create(path, false)) return 0;
+    std::atomic<bool> done(false);
+    size_t reader_seen = 0, reader_checks = 0;
+    double reader_error = 0;
+    std::thread reader([&] {
+        eigen_tutorial::MappedTrajectoryd follower;
+        if (!follower.open(path, false)) return;
+        while (!done || follower.refresh() > reader_seen) {
+            const size_t size = follower.refresh();
+            if (size > reader_seen) {
+                const size_t last = size - 1;
+                reader_error = std::max(reader_error,
+                                        (follower.isometry(last).matrix() - poses[last].matrix()).cwiseAbs().maxCoeff());
+                ++reader_checks;
+                reader_seen = size;
+            }
+        }
+    });
+    const size_t batch = 1000;
+    for (size_t b = 0; b < n; b += batch) live.append(poses.data() + b, batch);
+    done = true;
+    reader.join();
+    std::cout << "Live reader saw " << reader_seen << " poses over " << reader_checks
+              << " refreshes, max |error| of the newest pose = " << reader_error << "\n";
+
+    eigen_tutorial::MappedTrajectoryd second_writer;
+    std::cout << "Second appender on the same file: " << (second_writer.open(path, true) ? "allowed" : "refused")
+              << "\n";
+
+    live.close();
+    ::unlink(path.c_str());
+    return 0;
+}
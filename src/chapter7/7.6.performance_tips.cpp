@@ -2,6 +2,7 @@
  * Chapter 7.6: Performance Tips
  *
  * Topics: Fixed vs dynamic size, squaredNorm, benchmarking
+ * For repeatable numbers (warm-up, percentiles, JSON) use the `bench` target
  */
 
 #include <iostream>
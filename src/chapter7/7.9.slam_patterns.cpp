@@ -2,6 +2,8 @@
  * Chapter 7.9: SLAM-Specific Patterns
  *
  * Topics: Covariance propagation, information matrices, pose accumulation
+ *
+ * Compact, memory-mapped storage for long trajectories: 7.10
  */
 
 #include <iostream>
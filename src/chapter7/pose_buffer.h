@@ -0,0 +1,275 @@
+/**
+ * Time-indexed pose buffer with batched interpolation (see 7.11)
+ *
+ * Deskewing a LiDAR scan needs the sensor pose at every point's timestamp:
+ * ~1e5 - 1e6 queries per scan against a trajectory of a few hundred poses.
+ * PoseBuffer stores stamped poses (unit quaternion + translation) in SoA
+ * columns and answers queries by SLERP on the rotation and linear
+ * interpolation on the translation.
+ *
+ * Lookups: a single query binary-searches the stamps in O(log n), without
+ * branches so that random queries do not mispredict. A batch first tries
+ * the previous query's segment and the next one, so a sorted batch (the
+ * usual case: points come out of the sensor in time order) costs amortized
+ * O(1) per query; an out-of-order query falls back to the binary search.
+ *
+ * Interpolation runs on blocks of kPoseBlock queries in three passes:
+ * locate segments, compute the blend weights, blend. Per segment, push()
+ * precomputes the half-angle Omega between its two quaternions and
+ * 1 / sin(Omega), so SLERP costs two sines per query:
+ *
+ *   q(u) = sin((1 - u) Omega) / sin(Omega) q0 + sin(u Omega) / sin(Omega) q1
+ *
+ * Below kNlerpMaxAngle (rotation angle per segment) the weights are just
+ * 1 - u and u followed by a renormalization (nlerp), whose angular error is
+ * below ~3e-8 rad there. When a whole block only touches such segments, the
+ * weight pass has no transcendental calls and no branches. The results go
+ * straight into TrajectoryColumns (7.10), the same SoA layout the mapped
+ * trajectory store uses.
+ *
+ * push() keeps neighbouring quaternions in the same hemisphere, so the
+ * interpolation always takes the short way around.
+ */
+
+#ifndef EIGEN_TUTORIAL_POSE_BUFFER_H
+#define EIGEN_TUTORIAL_POSE_BUFFER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+#include "chapter7/mapped_trajectory.h"
+#include "common/parallel.h"
+
+namespace eigen_tutorial {
+
+// Rotation angle per segment below which interpolation uses nlerp
+const double kNlerpMaxAngle = 0.02;
+// Queries per interpolation block
+const size_t kPoseBlock = 64;
+// Below this many queries per thread, batches stay on one thread
+const size_t kPoseMinChunk = 1 << 14;
+
+template <typename Scalar>
+class PoseBuffer {
+public:
+    typedef Eigen::Quaternion<Scalar> Quaternion;
+    typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+
+    size_t size() const { return stamp_.size(); }
+    bool empty() const { return stamp_.empty(); }
+    double startTime() const { return stamp_.front(); }
+    double endTime() const { return stamp_.back(); }
+
+    void reserve(size_t n) {
+        stamp_.reserve(n);
+        for (int c = 0; c < 7; ++c) column_[c].reserve(n);
+        omega_.reserve(n);
+        inv_sin_omega_.reserve(n);
+    }
+
+    void clear() {
+        stamp_.clear();
+        for (int c = 0; c < 7; ++c) column_[c].clear();
+        omega_.clear();
+        inv_sin_omega_.clear();
+    }
+
+    // Appends a pose; stamps must be strictly increasing. Returns false (and
+    // leaves the buffer unchanged) otherwise.
+    bool push(double stamp, const Quaternion& q, const Vector3& t) {
+        if (!stamp_.empty() && !(stamp > stamp_.back())) return false;
+        Quaternion qn = q.normalized();
+        if (!stamp_.empty()) {
+            const size_t last = stamp_.size() - 1;
+            const Quaternion prev(column_[0][last], column_[1][last], column_[2][last], column_[3][last]);
+            Scalar d = prev.dot(qn);
+            if (d < 0) {
+                qn.coeffs() = -qn.coeffs();
+                d = -d;
+            }
+            // Half-angle of the segment; 2 Omega is the rotation angle
+            const Scalar omega = std::acos(std::min(d, Scalar(1)));
+            omega_.push_back(omega);
+            inv_sin_omega_.push_back(omega > Scalar(0) ? Scalar(1) / std::sin(omega) : Scalar(0));
+        }
+        stamp_.push_back(stamp);
+        column_[0].push_back(qn.w());
+        column_[1].push_back(qn.x());
+        column_[2].push_back(qn.y());
+        column_[3].push_back(qn.z());
+        column_[4].push_back(t.x());
+        column_[5].push_back(t.y());
+        column_[6].push_back(t.z());
+        return true;
+    }
+
+    bool push(double stamp, const Eigen::Isometry3d& T) {
+        return push(stamp, Eigen::Quaterniond(T.linear()).cast<Scalar>(), T.translation().cast<Scalar>());
+    }
+
+    // Pose at time t. Outside [startTime(), endTime()] the end pose is held
+    // and false is returned.
+    bool interpolate(double t, Quaternion* q, Vector3* p) const {
+        if (stamp_.empty()) return false;
+        size_t seg;
+        Scalar u;
+        const bool inside = locate(t, findSegment(t), seg, u);
+        Scalar w0, w1;
+        weights(seg, u, w0, w1);
+        blend(seg, u, w0, w1, q, p);
+        return inside;
+    }
+
+    bool interpolate(double t, Eigen::Isometry3d* T) const {
+        if (stamp_.empty()) return false;
+        Quaternion q;
+        Vector3 p;
+        const bool inside = interpolate(t, &q, &p);
+        T->linear() = q.template cast<double>().toRotationMatrix();
+        T->translation() = p.template cast<double>();
+        T->makeAffine();
+        return inside;
+    }
+
+    // Poses at times[0..n) into out[0..n) (out.stamp, if set, receives the
+    // query times). Any order works; sorted batches take the O(1) path.
+    // Returns how many queries fell inside [startTime(), endTime()].
+    size_t interpolate(const double* times, size_t n, const TrajectoryColumns<Scalar>& out) const {
+        if (stamp_.empty() || n == 0) return 0;
+        std::vector<size_t> inside(static_cast<size_t>(chunkCount(n, kPoseMinChunk)), 0);
+        forChunks(n, static_cast<int>(inside.size()), [&](int c, size_t b, size_t e) {
+            inside[static_cast<size_t>(c)] = interpolateRange(times, b, e, out);
+        });
+        size_t total = 0;
+        for (size_t k : inside) total += k;
+        return total;
+    }
+
+private:
+    // Largest i with stamp_[i] <= t (0 if none), clamped to a valid segment
+    // start. Branch-free halving: random queries would mispredict about half
+    // of std::upper_bound's comparisons.
+    size_t findSegment(double t) const {
+        const double* base = stamp_.data();
+        size_t len = stamp_.size();
+        while (len > 1) {
+            const size_t half = len / 2;
+            base = base[half] <= t ? base + half : base;
+            len -= half;
+        }
+        const size_t i = static_cast<size_t>(base - stamp_.data());
+        return std::min(i, segments() > 0 ? segments() - 1 : 0);
+    }
+
+    size_t segments() const { return stamp_.empty() ? 0 : stamp_.size() - 1; }
+
+    // Segment and fraction for t starting from a guess; clamps out-of-range
+    // times to the ends
+    bool locate(double t, size_t guess, size_t& seg, Scalar& u) const {
+        const size_t last = segments();
+        if (last == 0 || t <= stamp_.front()) {
+            seg = 0;
+            u = 0;
+            return t == stamp_.front();
+        }
+        if (t >= stamp_.back()) {
+            seg = last - 1;
+            u = 1;
+            return t == stamp_.back();
+        }
+        // Same or next segment as the previous query, else search
+        seg = guess;
+        if (t >= stamp_[seg + 1] && seg + 1 < last) ++seg;
+        if (t < stamp_[seg] || t >= stamp_[seg + 1]) seg = findSegment(t);
+        u = static_cast<Scalar>((t - stamp_[seg]) / (stamp_[seg + 1] - stamp_[seg]));
+        return true;
+    }
+
+    void weights(size_t seg, Scalar u, Scalar& w0, Scalar& w1) const {
+        if (segments() == 0 || omega_[seg] < Scalar(kNlerpMaxAngle / 2)) {
+            w0 = 1 - u;
+            w1 = u;
+        } else {
+            w0 = std::sin((1 - u) * omega_[seg]) * inv_sin_omega_[seg];
+            w1 = std::sin(u * omega_[seg]) * inv_sin_omega_[seg];
+        }
+    }
+
+    void blend(size_t seg, Scalar u, Scalar w0, Scalar w1, Quaternion* q, Vector3* p) const {
+        const size_t j = segments() == 0 ? seg : seg + 1;
+        Eigen::Matrix<Scalar, 4, 1> v;
+        for (int c = 0; c < 4; ++c) v(c) = w0 * column_[c][seg] + w1 * column_[c][j];
+        v.normalize();
+        *q = Quaternion(v(0), v(1), v(2), v(3));
+        for (int c = 0; c < 3; ++c) (*p)(c) = (1 - u) * column_[4 + c][seg] + u * column_[4 + c][j];
+    }
+
+    size_t interpolateRange(const double* times, size_t begin, size_t end,
+                            const TrajectoryColumns<Scalar>& out) const {
+        const size_t last = segments();
+        // One-pose buffers have no segments: both ends of every blend are pose 0
+        const size_t step = last == 0 ? 0 : 1;
+        const Scalar nlerp_omega = Scalar(kNlerpMaxAngle / 2);
+        size_t seg_of[kPoseBlock];
+        Scalar u[kPoseBlock], w0[kPoseBlock], w1[kPoseBlock];
+        size_t inside = 0;
+        size_t guess = findSegment(times[begin]);
+        for (size_t b = begin; b < end; b += kPoseBlock) {
+            const size_t len = std::min(kPoseBlock, end - b);
+
+            // Pass 1: segments and fractions
+            bool all_nlerp = true;
+            for (size_t k = 0; k < len; ++k) {
+                inside += locate(times[b + k], guess, seg_of[k], u[k]);
+                guess = seg_of[k];
+                all_nlerp = all_nlerp && (last == 0 || omega_[seg_of[k]] < nlerp_omega);
+            }
+
+            // Pass 2: blend weights
+            if (all_nlerp) {
+                for (size_t k = 0; k < len; ++k) {
+                    w0[k] = 1 - u[k];
+                    w1[k] = u[k];
+                }
+            } else {
+                for (size_t k = 0; k < len; ++k) weights(seg_of[k], u[k], w0[k], w1[k]);
+            }
+
+            // Pass 3: blend, renormalize and store
+            const TrajectoryColumns<Scalar> o = out.offset(b);
+            for (size_t k = 0; k < len; ++k) {
+                const size_t i = seg_of[k], j = i + step;
+                const Scalar qw = w0[k] * column_[0][i] + w1[k] * column_[0][j];
+                const Scalar qx = w0[k] * column_[1][i] + w1[k] * column_[1][j];
+                const Scalar qy = w0[k] * column_[2][i] + w1[k] * column_[2][j];
+                const Scalar qz = w0[k] * column_[3][i] + w1[k] * column_[3][j];
+                const Scalar inv_norm = Scalar(1) / std::sqrt(qw * qw + qx * qx + qy * qy + qz * qz);
+                o.qw[k] = qw * inv_norm;
+                o.qx[k] = qx * inv_norm;
+                o.qy[k] = qy * inv_norm;
+                o.qz[k] = qz * inv_norm;
+                o.tx[k] = (1 - u[k]) * column_[4][i] + u[k] * column_[4][j];
+                o.ty[k] = (1 - u[k]) * column_[5][i] + u[k] * column_[5][j];
+                o.tz[k] = (1 - u[k]) * column_[6][i] + u[k] * column_[6][j];
+                if (o.stamp) o.stamp[k] = times[b + k];
+            }
+        }
+        return inside;
+    }
+
+    std::vector<double> stamp_;
+    std::vector<Scalar> column_[7];      // qw qx qy qz tx ty tz
+    std::vector<Scalar> omega_;          // Per segment: half-angle between its quaternions
+    std::vector<Scalar> inv_sin_omega_;  // Per segment: 1 / sin(Omega), 0 if Omega = 0
+};
+
+typedef PoseBuffer<double> PoseBufferd;
+typedef PoseBuffer<float> PoseBufferf;
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_POSE_BUFFER_H
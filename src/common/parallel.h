@@ -0,0 +1,83 @@
+/**
+ * Minimal fork-join helpers on std::thread
+ *
+ * Work is split into a few contiguous chunks (one per thread) rather than a
+ * task queue: the bulk kernels in this project are uniform, so static
+ * partitioning is as good as stealing and keeps each chunk cache-friendly.
+ *
+ * The calling thread runs chunk 0 itself. Chunk bodies must not throw.
+ */
+
+#ifndef EIGEN_TUTORIAL_PARALLEL_H
+#define EIGEN_TUTORIAL_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace eigen_tutorial {
+
+namespace detail {
+inline std::atomic<int>& threadLimit() {
+    static std::atomic<int> limit(0);  // 0 = use all hardware threads
+    return limit;
+}
+}  // namespace detail
+
+// Caps the number of threads used by every parallel kernel (0 = hardware)
+inline void setNumThreads(int n) { detail::threadLimit() = std::max(0, n); }
+
+inline int numThreads() {
+    int limit = detail::threadLimit();
+    if (limit > 0) return limit;
+    int hw = static_cast<int>(std::thread::hardware_concurrency());
+    return hw > 0 ? hw : 1;
+}
+
+// How many chunks to split n items into so each has at least min_chunk items
+inline int chunkCount(size_t n, size_t min_chunk) {
+    if (min_chunk == 0) min_chunk = 1;
+    size_t by_size = std::max<size_t>(1, n / min_chunk);
+    return static_cast<int>(std::min<size_t>(by_size, numThreads()));
+}
+
+// [begin, end) of chunk `c` out of `chunks`, boundaries rounded to `align` items
+inline void chunkRange(size_t n, int chunks, int c, size_t align, size_t& begin, size_t& end) {
+    size_t per = (n + chunks - 1) / chunks;
+    per = (per + align - 1) / align * align;
+    begin = std::min(n, per * c);
+    end = std::min(n, begin + per);
+}
+
+// Runs fn(chunk, begin, end) for every chunk; blocks until all are done
+template <typename F>
+void forChunks(size_t n, int chunks, F&& fn, size_t align = 1) {
+    if (chunks <= 1) {
+        fn(0, size_t(0), n);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(chunks - 1);
+    for (int c = 1; c < chunks; ++c) {
+        size_t b, e;
+        chunkRange(n, chunks, c, align, b, e);
+        workers.emplace_back([&fn, c, b, e]() { fn(c, b, e); });
+    }
+    size_t b, e;
+    chunkRange(n, chunks, 0, align, b, e);
+    fn(0, b, e);
+    for (std::thread& w : workers) w.join();
+}
+
+// Runs fn(begin, end) over [0, n) on up to numThreads() threads
+template <typename F>
+void parallelFor(size_t n, size_t min_chunk, F&& fn, size_t align = 1) {
+    forChunks(n, chunkCount(n, min_chunk),
+              [&fn](int, size_t b, size_t e) { fn(b, e); }, align);
+}
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_PARALLEL_H
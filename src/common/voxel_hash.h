@@ -0,0 +1,185 @@
+/**
+ * Integer voxel keys and an open-addressing hash map keyed by them
+ *
+ * Points are bucketed by floor(p / voxel_size). The map uses linear probing
+ * over flat arrays (no per-node allocation, neighbouring probes share cache
+ * lines) and keeps the load factor at or below 1/2. Capacity only grows, so
+ * clear() followed by refilling to a similar size does not allocate.
+ */
+
+#ifndef EIGEN_TUTORIAL_VOXEL_HASH_H
+#define EIGEN_TUTORIAL_VOXEL_HASH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <Eigen/Core>
+
+namespace eigen_tutorial {
+
+struct VoxelKey {
+    int32_t x, y, z;
+
+    bool operator==(const VoxelKey& o) const { return x == o.x && y == o.y && z == o.z; }
+    bool operator!=(const VoxelKey& o) const { return !(*this == o); }
+};
+
+// Voxel containing p for voxels of edge 1 / inv_size
+template <typename Derived>
+inline VoxelKey voxelOf(const Eigen::MatrixBase<Derived>& p, typename Derived::Scalar inv_size) {
+    return VoxelKey{static_cast<int32_t>(std::floor(p(0) * inv_size)),
+                    static_cast<int32_t>(std::floor(p(1) * inv_size)),
+                    static_cast<int32_t>(std::floor(p(2) * inv_size))};
+}
+
+// Teschner et al.'s prime hash, finished with a multiplicative mix so that
+// the low bits used for the table index depend on all three coordinates
+inline uint64_t voxelHash(const VoxelKey& k) {
+    uint64_t h = (static_cast<uint64_t>(static_cast<uint32_t>(k.x)) * 73856093u) ^
+                 (static_cast<uint64_t>(static_cast<uint32_t>(k.y)) * 19349663u) ^
+                 (static_cast<uint64_t>(static_cast<uint32_t>(k.z)) * 83492791u);
+    h *= 0x9E3779B97F4A7C15ull;
+    return h ^ (h >> 29);
+}
+
+// Z-order (Morton) code of a voxel: sorting by it keeps voxels that are
+// close in space close in memory. Uses the low 21 bits of each coordinate.
+inline uint64_t mortonCode(const VoxelKey& k) {
+    auto spread = [](uint32_t v) {
+        uint64_t x = v & 0x1fffff;
+        x = (x | x << 32) & 0x1f00000000ffffull;
+        x = (x | x << 16) & 0x1f0000ff0000ffull;
+        x = (x | x << 8) & 0x100f00f00f00f00full;
+        x = (x | x << 4) & 0x10c30c30c30c30c3ull;
+        x = (x | x << 2) & 0x1249249249249249ull;
+        return x;
+    };
+    // Offset so that small negative coordinates do not wrap to the far end
+    const uint32_t bias = 1u << 20;
+    return spread(static_cast<uint32_t>(k.x) + bias) | spread(static_cast<uint32_t>(k.y) + bias) << 1 |
+           spread(static_cast<uint32_t>(k.z) + bias) << 2;
+}
+
+template <typename Value>
+class VoxelHashMap {
+public:
+    VoxelHashMap() { rehash(16); }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return keys_.size(); }
+
+    // Room for n voxels without rehashing
+    void reserve(size_t n) {
+        if (2 * n > keys_.size()) rehash(2 * n);
+    }
+
+    // Removes all voxels, keeps the memory
+    void clear() {
+        std::fill(used_.begin(), used_.end(), uint8_t(0));
+        size_ = 0;
+    }
+
+    Value* find(const VoxelKey& key) {
+        size_t i = slotOf(key);
+        return used_[i] ? &values_[i] : nullptr;
+    }
+    const Value* find(const VoxelKey& key) const {
+        size_t i = slotOf(key);
+        return used_[i] ? &values_[i] : nullptr;
+    }
+
+    // Value for key, value-initialized on first use; second = true if new
+    std::pair<Value*, bool> insert(const VoxelKey& key) {
+        if (2 * (size_ + 1) > keys_.size()) rehash(2 * keys_.size());
+        size_t i = slotOf(key);
+        if (used_[i]) return std::make_pair(&values_[i], false);
+        used_[i] = 1;
+        keys_[i] = key;
+        values_[i] = Value();
+        ++size_;
+        return std::make_pair(&values_[i], true);
+    }
+
+    Value& operator[](const VoxelKey& key) { return *insert(key).first; }
+
+    // Removes every voxel for which pred(key, value) is true; returns how many.
+    // Survivors are re-inserted, since linear probing cannot leave holes.
+    template <typename Pred>
+    size_t eraseIf(Pred&& pred) {
+        spare_keys_.clear();
+        spare_values_.clear();
+        for (size_t i = 0; i < keys_.size(); ++i) {
+            if (used_[i] && !pred(static_cast<const VoxelKey&>(keys_[i]), static_cast<const Value&>(values_[i]))) {
+                spare_keys_.push_back(keys_[i]);
+                spare_values_.push_back(std::move(values_[i]));
+            }
+        }
+        const size_t erased = size_ - spare_keys_.size();
+        clear();
+        for (size_t i = 0; i < spare_keys_.size(); ++i) {
+            size_t j = slotOf(spare_keys_[i]);
+            used_[j] = 1;
+            keys_[j] = spare_keys_[i];
+            values_[j] = std::move(spare_values_[i]);
+        }
+        size_ = spare_keys_.size();
+        return erased;
+    }
+
+    // fn(const VoxelKey&, Value&) for every voxel, in table order
+    template <typename F>
+    void forEach(F&& fn) {
+        for (size_t i = 0; i < keys_.size(); ++i) {
+            if (used_[i]) fn(keys_[i], values_[i]);
+        }
+    }
+    template <typename F>
+    void forEach(F&& fn) const {
+        for (size_t i = 0; i < keys_.size(); ++i) {
+            if (used_[i]) fn(keys_[i], values_[i]);
+        }
+    }
+
+private:
+    // Slot holding key, or the empty slot where it would go
+    size_t slotOf(const VoxelKey& key) const {
+        size_t i = static_cast<size_t>(voxelHash(key)) & mask_;
+        while (used_[i] && keys_[i] != key) i = (i + 1) & mask_;
+        return i;
+    }
+
+    void rehash(size_t min_capacity) {
+        size_t cap = 16;
+        while (cap < min_capacity) cap *= 2;
+        std::vector<VoxelKey> keys(cap);
+        std::vector<Value, Eigen::aligned_allocator<Value>> values(cap);
+        std::vector<uint8_t> used(cap, 0);
+        keys.swap(keys_);
+        values.swap(values_);
+        used.swap(used_);
+        mask_ = cap - 1;
+        for (size_t i = 0; i < used.size(); ++i) {
+            if (!used[i]) continue;
+            size_t j = slotOf(keys[i]);
+            used_[j] = 1;
+            keys_[j] = keys[i];
+            values_[j] = std::move(values[i]);
+        }
+    }
+
+    std::vector<VoxelKey> keys_;
+    std::vector<Value, Eigen::aligned_allocator<Value>> values_;
+    std::vector<uint8_t> used_;
+    std::vector<VoxelKey> spare_keys_;  // eraseIf() scratch, kept for reuse
+    std::vector<Value, Eigen::aligned_allocator<Value>> spare_values_;
+    size_t mask_ = 0;
+    size_t size_ = 0;
+};
+
+}  // namespace eigen_tutorial
+
+#endif  // EIGEN_TUTORIAL_VOXEL_HASH_H